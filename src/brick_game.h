@@ -9,10 +9,13 @@
 #ifdef __cplusplus
 
 #include "components/GameFactory/GameFactory.h"
+#include "components/Replay/Replay.h"
 
 extern "C" {
 #endif
 
+#include "components/persist/persist.h"
+
 #ifdef __cplusplus
 }
 #endif
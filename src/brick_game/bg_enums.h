@@ -33,6 +33,7 @@ typedef enum {
   QUIT = 'q',         ///< Quit key
   PAUSE = 'p',        ///< Pause key
   ACTION = ' ',       ///< Rotation key
+  STATS = 0424,       ///< Latency report key, handled by the view
 
 } Keys;
 
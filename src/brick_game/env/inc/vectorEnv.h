@@ -0,0 +1,237 @@
+/**
+ * @file
+ * @brief Header file for the vectorized game environment
+ */
+
+#ifndef VECTORENV_H
+#define VECTORENV_H
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../../snake/inc/snakeModel.h"
+
+extern "C" {
+#endif
+
+#include "../../tetris/inc/simulator.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Game simulated by the environment
+ */
+enum class EnvGame : int {
+  Tetris = 0,  ///< Tetris
+  Snake        ///< Snake
+};
+
+/**
+ * @brief Batch of independent games stepped with one call
+ *
+ * @details The environment keeps the boards of all games as one contiguous
+ * array of row masks, updated only in the rows a game changed. Results are
+ * published in the same structure-of-arrays layout: observations are row
+ * masks, scores, levels and states live in parallel arrays. Games are split
+ * into shards, every shard is stepped by its own worker thread
+ */
+class VectorEnv {
+  //! @brief Game of every environment
+  EnvGame game_;
+
+  //! @brief Number of games
+  int count_;
+
+  //! @brief Observation rows of one game
+  int rows_;
+
+  //! @brief Tetris games
+  std::vector<TetrisSimulator> tetris_;
+
+  //! @brief Snake games
+  std::unique_ptr<SnakeModel[]> snakes_;
+
+  //! @brief Row masks of every game, rows_ per game: the attached blocks
+  //!        of Tetris, the snake and the apple of Snake
+  std::vector<uint16_t> boards_;
+
+  //! @brief Score of every game
+  std::vector<int> scores_;
+
+  //! @brief Level of every game
+  std::vector<int> levels_;
+
+  //! @brief State of every game
+  std::vector<State> states_;
+
+  //! @brief Games finished by every environment
+  std::vector<uint64_t> episodes_;
+
+  //! @brief Start of every shard, the last entry is the count
+  std::vector<int> bounds_;
+
+  //! @brief Worker of every shard but the first
+  std::vector<std::thread> workers_;
+
+  //! @brief Step start point
+  std::barrier<> start_;
+
+  //! @brief Step end point
+  std::barrier<> done_;
+
+  //! @brief Workers have to exit
+  std::atomic<bool> stop_;
+
+  //! @brief Actions of the current step
+  const UserAction_t *actions_;
+
+  //! @brief Observations of the current step
+  uint16_t *observations_;
+
+  //! @brief Rewards of the current step
+  float *rewards_;
+
+ public:
+  /**
+   * @brief VectorEnv constructor
+   * @param game Game of every environment
+   * @param count Number of games
+   * @param shards Number of worker threads
+   */
+  VectorEnv(EnvGame game, int count, int shards = 1);
+
+  /**
+   * @brief VectorEnv destructor
+   */
+  ~VectorEnv();
+
+  VectorEnv(const VectorEnv &) = delete;
+  VectorEnv &operator=(const VectorEnv &) = delete;
+
+  /**
+   * @brief Advance every game by one tick
+   * @param actions Action of every game, count entries
+   * @param observations Row masks of every game, count * rows() entries
+   * @param rewards Reward of every game, count entries
+   *
+   * @details A reward is the score gained on this tick, or -1 if the game
+   * was lost. Lost games are restarted by the next Start action
+   *
+   * @throw std::invalid_argument if an action is Terminate, environments
+   * are never terminated
+   */
+  void step(const UserAction_t *actions, uint16_t *observations,
+            float *rewards);
+
+  /**
+   * @brief Seed the random generators of all games
+   * @param seed Seed of game 0, game i gets seed + i
+   *
+   * @details Call it between steps, the same seeds and actions give
+   * the same games on any number of shards
+   */
+  void seed(uint64_t seed);
+
+  /**
+   * @brief Choose the randomizer of the Tetris figures
+   * @param bagged True for the 7-bag, false for uniform draws
+   *
+   * @details Call it between steps, every game is seeded again with its
+   * seed. Snake games ignore it
+   */
+  void bag(bool bagged);
+
+  /**
+   * @brief Number of games
+   * @return Number of games
+   */
+  int size() const;
+
+  /**
+   * @brief Observation rows of one game
+   * @return Number of rows, bit j of a row is the j-th playable column
+   */
+  int rows() const;
+
+  /**
+   * @brief Number of shards
+   * @return Number of shards
+   */
+  int shards() const;
+
+  /**
+   * @brief Scores of all games
+   * @return Array of size() scores
+   */
+  const int *scores() const;
+
+  /**
+   * @brief Levels of all games
+   * @return Array of size() levels
+   */
+  const int *levels() const;
+
+  /**
+   * @brief States of all games
+   * @return Array of size() states
+   */
+  const State *states() const;
+
+  /**
+   * @brief Finished games of all environments
+   * @return Array of size() counters
+   */
+  const uint64_t *episodes() const;
+
+ private:
+  /**
+   * @brief Worker thread loop
+   * @param shard Shard of the worker
+   */
+  void work(int shard);
+
+  /**
+   * @brief Apply the changed cells of a Snake game to its board
+   * @param index Game number
+   */
+  void syncSnake(int index);
+
+  /**
+   * @brief Advance the games of one shard
+   * @param shard Shard number
+   */
+  void stepShard(int shard);
+
+  /**
+   * @brief Advance one Tetris game
+   * @param index Game number
+   * @param action User action
+   * @param observation Row masks of the game
+   * @return Reward
+   */
+  float stepTetris(int index, UserAction_t action, uint16_t *observation);
+
+  /**
+   * @brief Advance one Snake game
+   * @param index Game number
+   * @param action User action
+   * @param observation Row masks of the game
+   * @return Reward
+   */
+  float stepSnake(int index, UserAction_t action, uint16_t *observation);
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,337 @@
+#include "../inc/vectorEnv.h"
+
+namespace s21 {
+
+/**
+ * @brief Key the frontend would send along with an action
+ * @param action User action
+ * @param running The game is being played
+ * @return Pressed key, -1 for a plain tick
+ */
+static int actionKey(UserAction_t action, bool running) {
+  switch (action) {
+    case UserAction_t::Start:
+      return running ? -1 : ENTER;
+    case UserAction_t::Pause:
+      return PAUSE;
+    case UserAction_t::Left:
+      return ArrowLeft;
+    case UserAction_t::Right:
+      return ArrowRight;
+    case UserAction_t::Up:
+      return ArrowUp;
+    case UserAction_t::Down:
+      return ArrowDown;
+    case UserAction_t::Action:
+      return ACTION;
+    default:
+      return -1;
+  }
+}
+
+/**
+ * @brief VectorEnv constructor
+ * @param game Game of every environment
+ * @param count Number of games
+ * @param shards Number of worker threads
+ */
+VectorEnv::VectorEnv(EnvGame game, int count, int shards)
+    : game_(game),
+      count_(count),
+      rows_(game == EnvGame::Tetris ? FieldRows - 1
+                                    : static_cast<int>(Field::height) - 1),
+      boards_(static_cast<size_t>(count) * rows_),
+      scores_(count),
+      levels_(count),
+      states_(count),
+      episodes_(count),
+      start_(std::max(1, std::min(shards, count))),
+      done_(std::max(1, std::min(shards, count))),
+      stop_(false),
+      actions_(nullptr),
+      observations_(nullptr),
+      rewards_(nullptr) {
+  if (game_ == EnvGame::Tetris) {
+    tetris_.resize(count_);
+    for (auto &sim : tetris_) ::TetrisSimInit(&sim);
+  } else {
+    snakes_ = std::make_unique<SnakeModel[]>(count_);
+
+    for (int i = 0; i < count_; ++i) {
+      snakes_[i].setPersistent(false);
+      syncSnake(i);
+    }
+  }
+
+  for (int i = 0; i < count_; ++i) {
+    GameInfo_t gameInfo = game_ == EnvGame::Tetris
+                              ? ::TetrisUpdateCurrentState(&tetris_[i].ctx)
+                              : snakes_[i].updateCurrentState();
+
+    scores_[i] = gameInfo.score;
+    levels_[i] = gameInfo.level;
+    states_[i] = State::Launch;
+  }
+
+  int shardCount = std::max(1, std::min(shards, count));
+
+  for (int s = 0; s <= shardCount; ++s)
+    bounds_.push_back(static_cast<int>(1LL * count_ * s / shardCount));
+
+  for (int s = 1; s < shardCount; ++s)
+    workers_.emplace_back(&VectorEnv::work, this, s);
+}
+
+/**
+ * @brief VectorEnv destructor
+ */
+VectorEnv::~VectorEnv() {
+  stop_ = true;
+  start_.arrive_and_wait();
+
+  for (auto &worker : workers_) worker.join();
+
+  for (auto &sim : tetris_) ::TetrisSimDestroy(&sim);
+}
+
+/**
+ * @brief Advance every game by one tick
+ * @param actions Action of every game, count entries
+ * @param observations Row masks of every game, count * rows() entries
+ * @param rewards Reward of every game, count entries
+ */
+void VectorEnv::step(const UserAction_t *actions, uint16_t *observations,
+                     float *rewards) {
+  if (std::find(actions, actions + count_, UserAction_t::Terminate) !=
+      actions + count_)
+    throw std::invalid_argument("VectorEnv: Terminate is not an action");
+
+  actions_ = actions;
+  observations_ = observations;
+  rewards_ = rewards;
+
+  start_.arrive_and_wait();
+  stepShard(0);
+  done_.arrive_and_wait();
+}
+
+/**
+ * @brief Worker thread loop
+ * @param shard Shard of the worker
+ */
+void VectorEnv::work(int shard) {
+  while (true) {
+    start_.arrive_and_wait();
+
+    if (stop_) return;
+
+    stepShard(shard);
+    done_.arrive_and_wait();
+  }
+}
+
+/**
+ * @brief Advance the games of one shard
+ * @param shard Shard number
+ */
+void VectorEnv::stepShard(int shard) {
+  for (int i = bounds_[shard]; i < bounds_[shard + 1]; ++i) {
+    uint16_t *observation = observations_ + static_cast<size_t>(i) * rows_;
+
+    rewards_[i] = game_ == EnvGame::Tetris
+                      ? stepTetris(i, actions_[i], observation)
+                      : stepSnake(i, actions_[i], observation);
+  }
+}
+
+/**
+ * @brief Advance one Tetris game
+ * @param index Game number
+ * @param action User action
+ * @param observation Row masks of the game
+ * @return Reward
+ */
+float VectorEnv::stepTetris(int index, UserAction_t action,
+                            uint16_t *observation) {
+  TetrisSimulator *sim = &tetris_[index];
+  uint64_t games = sim->games;
+
+  ::TetrisSimStep(sim, &action, 1);
+
+  TetrisContext *ctx = &sim->ctx;
+  uint16_t *board = boards_.data() + static_cast<size_t>(index) * rows_;
+  uint32_t changed = ::TetrisTakeChangedRows(ctx) & ((1u << rows_) - 1);
+
+  for (; changed; changed &= changed - 1) {
+    int i = __builtin_ctz(changed);
+
+    board[i] = (ctx->board.rows[i] & RowFullMask) >> LeftBorder;
+  }
+
+  std::copy(board, board + rows_, observation);
+
+  if (ctx->figure.active) {
+    const TetrisFigure *figure = &ctx->figure;
+    const FigureRotation *rotation =
+        &figureRotations[figure->type][figure->rotation];
+
+    int top = figure->row + rotation->top;
+    int left = figure->col + rotation->left;
+
+    for (int i = 0; i < rotation->height; ++i)
+      observation[top + i] |=
+          ((rotation->masks[i] << left) & RowFullMask) >> LeftBorder;
+  }
+
+  int score = ctx->gameInfo.score;
+  float reward = static_cast<float>(score - scores_[index]);
+
+  if (sim->games != games) {
+    reward = -1.0f;
+    episodes_[index]++;
+  }
+
+  scores_[index] = score;
+  levels_[index] = ctx->gameInfo.level;
+  states_[index] = ::TetrisGetState(ctx);
+
+  return reward;
+}
+
+/**
+ * @brief Advance one Snake game
+ * @param index Game number
+ * @param action User action
+ * @param observation Row masks of the game
+ * @return Reward
+ */
+float VectorEnv::stepSnake(int index, UserAction_t action,
+                           uint16_t *observation) {
+  SnakeModel &snake = snakes_[index];
+  State before = snake.getState();
+
+  bool running = before != State::Launch && before != State::GameOver;
+  int key = actionKey(action, running);
+
+  snake.setKey(key);
+  snake.userInput(action, key != -1 && key == snake.getLastKey());
+
+  syncSnake(index);
+
+  const uint16_t *board = boards_.data() + static_cast<size_t>(index) * rows_;
+  GameInfo_t gameInfo = snake.updateCurrentState();
+
+  std::copy(board, board + rows_, observation);
+
+  State state = snake.getState();
+  float reward = 0.0f;
+
+  if (state == State::GameOver && before != State::GameOver) {
+    reward = -1.0f;
+    scores_[index] = 0;
+    episodes_[index]++;
+  } else if (gameInfo.score >= 0) {
+    reward = static_cast<float>(gameInfo.score - scores_[index]);
+    scores_[index] = gameInfo.score;
+  }
+
+  if (gameInfo.level > 0) levels_[index] = gameInfo.level;
+
+  states_[index] = state;
+
+  return reward;
+}
+
+/**
+ * @brief Apply the changed cells of a Snake game to its board
+ * @param index Game number
+ *
+ * @details The frame delta only compares the rows the game wrote, so
+ *          a tick costs the few cells the snake and the apple moved
+ */
+void VectorEnv::syncSnake(int index) {
+  uint16_t *board = boards_.data() + static_cast<size_t>(index) * rows_;
+  const FrameDelta &delta = snakes_[index].updateFrameDelta();
+  int widthField = static_cast<int>(Field::width);
+
+  for (int k = 0; k < delta.count; ++k) {
+    const CellChange &cell = delta.cells[k];
+
+    if (cell.row >= rows_ || cell.col < 1 || cell.col >= widthField - 1)
+      continue;
+
+    uint16_t bit = static_cast<uint16_t>(1u << (cell.col - 1));
+
+    if (cell.value != ' ')
+      board[cell.row] |= bit;
+    else
+      board[cell.row] &= ~bit;
+  }
+}
+
+/**
+ * @brief Seed the random generators of all games
+ * @param seed Seed of game 0, game i gets seed + i
+ */
+void VectorEnv::seed(uint64_t seed) {
+  for (int i = 0; i < count_; ++i)
+    if (game_ == EnvGame::Tetris)
+      ::TetrisSetSeed(&tetris_[i].ctx, seed + i);
+    else
+      snakes_[i].setSeed(seed + i);
+}
+
+/**
+ * @brief Choose the randomizer of the Tetris figures
+ * @param bagged True for the 7-bag, false for uniform draws
+ */
+void VectorEnv::bag(bool bagged) {
+  for (int i = 0; i < count_; ++i)
+    if (game_ == EnvGame::Tetris)
+      ::TetrisSimSetBag(&tetris_[i], bagged);
+    else
+      snakes_[i].setBag(bagged);
+}
+
+/**
+ * @brief Number of games
+ * @return Number of games
+ */
+int VectorEnv::size() const { return count_; }
+
+/**
+ * @brief Observation rows of one game
+ * @return Number of rows, bit j of a row is the j-th playable column
+ */
+int VectorEnv::rows() const { return rows_; }
+
+/**
+ * @brief Number of shards
+ * @return Number of shards
+ */
+int VectorEnv::shards() const { return static_cast<int>(bounds_.size()) - 1; }
+
+/**
+ * @brief Scores of all games
+ * @return Array of size() scores
+ */
+const int *VectorEnv::scores() const { return scores_.data(); }
+
+/**
+ * @brief Levels of all games
+ * @return Array of size() levels
+ */
+const int *VectorEnv::levels() const { return levels_.data(); }
+
+/**
+ * @brief States of all games
+ * @return Array of size() states
+ */
+const State *VectorEnv::states() const { return states_.data(); }
+
+/**
+ * @brief Finished games of all environments
+ * @return Array of size() counters
+ */
+const uint64_t *VectorEnv::episodes() const { return episodes_.data(); }
+}  // namespace s21
@@ -8,6 +8,8 @@
 
 #ifdef __cplusplus
 
+#include <array>
+#include <bitset>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -19,6 +21,13 @@ extern "C" {
 
 #include <sys/stat.h>
 
+#include "../../../components/cmatrix/cmatrix.h"
+#include "../../../components/leaderboard/leaderboard.h"
+#include "../../../components/persist/persist.h"
+#include "../../../components/random/random.h"
+#include "../../../components/scorestore/scorestore.h"
+#include "../../../components/trace/trace.h"
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,10 +81,25 @@ struct Point {
 class SnakeModel : public IModel {
   /**
    * @brief Class for snake
+   *
+   * @details The body is a ring buffer, so a move only writes the new head
+   * and drops the tail
    */
   class Snake {
-    ///! @brief Snake
-    std::vector<Point> snake_;
+    ///! @brief Ring capacity, a power of two above the field size
+    static constexpr int capacity = 256;
+
+    ///! @brief Body segments
+    std::array<Point, capacity> body_;
+
+    ///! @brief Ring index of the head
+    int head_;
+
+    ///! @brief Number of segments on the field
+    int count_;
+
+    ///! @brief Segments still to grow
+    int growth_;
 
     ///! @brief Direction
     Direction direction_;
@@ -105,17 +129,21 @@ class SnakeModel : public IModel {
 
     /**
      * @brief Moving the snake one step
+     * @param vacated Cell left by the tail
+     * @return True if the tail left a cell, false while growing
      */
-    void move();
+    bool move(Point& vacated);
 
     /**
      * @brief Adding a segment to the snake tail
+     *
+     * @details The tail stays in place on the next move
      */
     void addSegment();
 
     /**
      * @brief Getting the size of the snake
-     * @return Size of the snake
+     * @return Size of the snake, including the segments still to grow
      */
     int size() const;
 
@@ -162,6 +190,47 @@ class SnakeModel : public IModel {
   //! @brief Clicks counter
   int hold_counter = 0;
 
+  //! @brief Cells of the field with a wall row above it
+  static constexpr int cells =
+      (static_cast<int>(Field::height) + 1) * static_cast<int>(Field::width);
+
+  //! @brief Wall cells
+  std::bitset<cells> walls_;
+
+  //! @brief Cells taken by the snake
+  std::bitset<cells> occupied_;
+
+  //! @brief Playable cells of the field
+  static constexpr int playableCells = (static_cast<int>(Field::height) - 1) *
+                                       (static_cast<int>(Field::width) - 2);
+
+  //! @brief Free playable cells in no particular order
+  std::array<int, playableCells> freeCells_;
+
+  //! @brief Position of every cell in freeCells_, -1 if it is not free
+  std::array<int, cells> freeSlots_;
+
+  //! @brief Number of free playable cells
+  int freeCount_;
+
+  //! @brief Changes not reported to the frame delta yet
+  DeltaTracker tracker_;
+
+  //! @brief Leaderboard of finished games, nullptr for none
+  const char* records_;
+
+  //! @brief High score and finished games are saved
+  bool persistent_;
+
+  //! @brief Start of this game, LeaderboardNow
+  uint64_t started_;
+
+  //! @brief Generator of the apples
+  Random rng_;
+
+  //! @brief Seed of the generator
+  uint64_t seed_;
+
  public:
   /**
    * @brief SnakeModel constructor
@@ -173,6 +242,18 @@ class SnakeModel : public IModel {
    */
   ~SnakeModel() override;
 
+  /**
+   * @brief SnakeModel copy constructor
+   * @param other Game to copy
+   */
+  SnakeModel(const SnakeModel& other);
+
+  /**
+   * @brief SnakeModel copy assignment
+   * @param other Game to copy
+   */
+  SnakeModel& operator=(const SnakeModel& other);
+
   /**
    * @brief User input accepts a user action as input
    * @param action User action
@@ -192,6 +273,16 @@ class SnakeModel : public IModel {
    */
   GameInfo_t updateCurrentState() override;
 
+  /**
+   * @brief Changes of the game since the previous call
+   * @return Changed cells and numbers
+   * @see FrameDelta
+   *
+   * @details Network mirrors and incremental renderers apply it
+   *          instead of rescanning the whole field
+   */
+  const FrameDelta& updateFrameDelta() override;
+
   /**
    * @brief Set key for cuurent input
    * @param key Input key
@@ -211,6 +302,59 @@ class SnakeModel : public IModel {
    */
   State getState() override;
 
+  /**
+   * @brief Seed the random generator of the game
+   * @param seed Seed
+   *
+   * @details The same seed and the same input give the same game
+   */
+  void setSeed(uint64_t seed) override;
+
+  /**
+   * @brief Get the seed of the random generator
+   * @return Seed, random unless set
+   */
+  uint64_t getSeed() override;
+
+  /**
+   * @brief Choose the randomizer of the pieces
+   * @param bagged Ignored, the apples are always drawn uniformly
+   */
+  void setBag(bool bagged) override;
+
+  /**
+   * @brief Set the leaderboard of finished games
+   * @param path Path to the leaderboard file, nullptr to skip
+   */
+  void setRecords(const char* path) override;
+
+  /**
+   * @brief Keep the results of finished games
+   * @param persistent False skips the high score and the leaderboard
+   *
+   * @details Replayed and simulated games are not saved
+   */
+  void setPersistent(bool persistent) override;
+
+  /**
+   * @brief Take the high score of the player from the records
+   */
+  void loadHighScore() override;
+
+  /**
+   * @brief Copy the game
+   * @return Independent game in the same state
+   *
+   * @details Replays keep snapshots to seek without starting over
+   */
+  std::unique_ptr<IModel> snapshot() override;
+
+  /**
+   * @brief Take the state of a snapshot
+   * @param snapshot Snapshot of a game of the same type
+   */
+  void restore(const IModel& snapshot) override;
+
  private:
   /**
    * @brief Game info structure initialization
@@ -234,6 +378,17 @@ class SnakeModel : public IModel {
    */
   void resetGame();
 
+  /**
+   * @brief Record the finished game in the leaderboard
+   */
+  void recordGame();
+
+  /**
+   * @brief Save the high score of the game
+   * @param high_score High score
+   */
+  void saveScore(int high_score);
+
   /**
    * @brief Reset game info structure
    */
@@ -249,6 +404,11 @@ class SnakeModel : public IModel {
    */
   void putSnake();
 
+  /**
+   * @brief Put the new head on the field and turn the old one into body
+   */
+  void putHead();
+
   /**
    * @brief Remove apple from the field
    */
@@ -261,8 +421,9 @@ class SnakeModel : public IModel {
 
   /**
    * @brief Spawn apple new position
+   * @return False if there is no free cell left
    */
-  void spawnApple();
+  bool spawnApple();
 
   /**
    * @brief Apple eating logic
@@ -274,6 +435,13 @@ class SnakeModel : public IModel {
    */
   void clearGameField();
 
+  /**
+   * @brief Write a cell of the field
+   * @param point Cell
+   * @param value New value
+   */
+  void setCell(const Point& point, int value);
+
   /**
    * @brief Check if there is a collision
    * @return True if there is a collision
@@ -311,6 +479,30 @@ class SnakeModel : public IModel {
    */
   int defineTime(int time);
 
+  /**
+   * @brief Mark a cell as taken by the snake
+   * @param point Cell
+   */
+  void occupy(const Point& point);
+
+  /**
+   * @brief Mark a cell as left by the snake
+   * @param point Cell
+   */
+  void vacate(const Point& point);
+
+  /**
+   * @brief Mark every playable cell as free
+   */
+  void resetCells();
+
+  /**
+   * @brief Bit of a cell in the occupancy sets
+   * @param point Cell, one step outside the field at most
+   * @return Bit number
+   */
+  static int cellIndex(const Point& point);
+
   /**
    * @brief Create new matrix
    * @param height Height
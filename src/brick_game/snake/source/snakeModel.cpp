@@ -7,12 +7,11 @@ namespace s21 {
  * @param count Size of the snake
  */
 SnakeModel::Snake::Snake(int count)
-    : snake_(count), direction_(Direction::Right) {
-  snake_.reserve(201);
-
+    : body_{}, head_(0), count_(count), growth_(0),
+      direction_(Direction::Right) {
   for (int i = 0; i < count; ++i) {
-    snake_[i].y = 7;
-    snake_[i].x = 5 - i;
+    body_[(capacity - i) % capacity].y = 7;
+    body_[(capacity - i) % capacity].x = 5 - i;
   }
 }
 
@@ -27,11 +26,13 @@ SnakeModel::Snake::~Snake() {}
 void SnakeModel::Snake::reset() {
   int count = 4;
 
-  snake_.resize(count);
+  head_ = 0;
+  count_ = count;
+  growth_ = 0;
 
   for (int i = 0; i < count; ++i) {
-    snake_[i].y = 7;
-    snake_[i].x = 5 - i;
+    body_[(capacity - i) % capacity].y = 7;
+    body_[(capacity - i) % capacity].x = 5 - i;
   }
 
   direction_ = Direction::Right;
@@ -61,45 +62,64 @@ void SnakeModel::Snake::setDirection(Direction direction) {
 /**
  * @brief Getting the coordinates of the snake segment
  * @return Coordinates
+ *
+ * @details Segments still to grow share the cell of the tail
  */
 const Point &SnakeModel::Snake::operator[](int index) const {
-  return snake_[index];
+  if (index >= count_) index = count_ - 1;
+
+  return body_[(head_ - index) & (capacity - 1)];
 }
 
 /**
  * @brief Getting the size of the snake
- * @return Size of the snake
+ * @return Size of the snake, including the segments still to grow
  */
-int SnakeModel::Snake::size() const { return snake_.size(); }
+int SnakeModel::Snake::size() const { return count_ + growth_; }
 
 /**
  * @brief Moving the snake one step
+ * @param vacated Cell left by the tail
+ * @return True if the tail left a cell, false while growing
  */
-void SnakeModel::Snake::move() {
-  for (int i = snake_.size() - 1; i > 0; --i) snake_[i] = snake_[i - 1];
+bool SnakeModel::Snake::move(Point &vacated) {
+  Point head = body_[head_];
 
   switch (direction_) {
     case Direction::Right:
-      snake_[0].x += 1;
+      head.x += 1;
       break;
     case Direction::Left:
-      snake_[0].x -= 1;
+      head.x -= 1;
       break;
     case Direction::Up:
-      snake_[0].y -= 1;
+      head.y -= 1;
       break;
     case Direction::Down:
-      snake_[0].y += 1;
+      head.y += 1;
       break;
   }
+
+  vacated = (*this)[count_ - 1];
+
+  head_ = (head_ + 1) & (capacity - 1);
+  body_[head_] = head;
+
+  if (growth_ > 0) {
+    growth_--;
+    count_++;
+    return false;
+  }
+
+  return true;
 }
 
 /**
  * @brief Adding a segment to the snake tail
+ *
+ * @details The tail stays in place on the next move
  */
-void SnakeModel::Snake::addSegment() {
-  snake_.push_back(snake_[snake_.size() - 2]);
-}
+void SnakeModel::Snake::addSegment() { growth_++; }
 
 /**
  * @brief SnakeModel constructor
@@ -110,13 +130,18 @@ SnakeModel::SnakeModel()
                            static_cast<int>(Field::width))},
       gameInfo_{gameInfoInit()},
       score_(0),
-      high_score_(getHighScore("records/records")),
+      high_score_(0),
       level_(1),
       snake_(4),
       apple_({4, 7}),
       key_(0),
       lastKey_(0),
-      gameOver_(false) {
+      gameOver_(false),
+      records_("records/leaderboard"),
+      persistent_(true),
+      started_(LeaderboardNow()),
+      rng_{},
+      seed_(0) {
   int heightField = static_cast<int>(Field::height);
   int widthField = static_cast<int>(Field::width);
 
@@ -131,17 +156,110 @@ SnakeModel::SnakeModel()
   gameField_[0][0] = heightField;
   gameField_[1][0] = widthField;
 
+  for (int i = -1; i < heightField; ++i)
+    for (int j = 0; j < widthField; ++j)
+      if (j == 0 || j == widthField - 1 || i < 0 || i == heightField - 1)
+        walls_.set(cellIndex({i, j}));
+
+  resetCells();
+
+  if (DeltaTrackerInit(&tracker_, heightField, widthField))
+    throw std::bad_alloc();
+
   gameInfo_.high_score = high_score_;
+
+  setSeed(RandomEntropy());
 }
 
 /**
  * @brief SnakeModel destructor
  */
 SnakeModel::~SnakeModel() {
+  DeltaTrackerDestroy(&tracker_);
+  RemoveMatrix(gameField_, static_cast<int>(Field::height));
+}
+
+/**
+ * @brief SnakeModel copy constructor
+ * @param other Game to copy
+ */
+SnakeModel::SnakeModel(const SnakeModel &other)
+    : state_(other.state_),
+      gameField_{newMatrix(static_cast<int>(Field::height),
+                           static_cast<int>(Field::width))},
+      gameInfo_(other.gameInfo_),
+      score_(other.score_),
+      high_score_(other.high_score_),
+      level_(other.level_),
+      snake_(other.snake_),
+      apple_(other.apple_),
+      key_(other.key_),
+      lastKey_(other.lastKey_),
+      gameOver_(other.gameOver_),
+      hold_counter(other.hold_counter),
+      walls_(other.walls_),
+      occupied_(other.occupied_),
+      freeCells_(other.freeCells_),
+      freeSlots_(other.freeSlots_),
+      freeCount_(other.freeCount_),
+      tracker_{},
+      records_(other.records_),
+      persistent_(other.persistent_),
+      started_(other.started_),
+      rng_(other.rng_),
+      seed_(other.seed_) {
   int heightField = static_cast<int>(Field::height);
+  int widthField = static_cast<int>(Field::width);
+
+  for (int i = 0; i < heightField; ++i)
+    for (int j = 0; j < widthField; ++j)
+      gameField_[i][j] = other.gameField_[i][j];
+
+  gameInfo_.field = gameField_;
+
+  if (DeltaTrackerInit(&tracker_, heightField, widthField))
+    throw std::bad_alloc();
+
+  DeltaTrackerCopy(&tracker_, &other.tracker_);
+}
+
+/**
+ * @brief SnakeModel copy assignment
+ * @param other Game to copy
+ */
+SnakeModel &SnakeModel::operator=(const SnakeModel &other) {
+  if (this == &other) return *this;
+
+  for (int i = 0; i < static_cast<int>(Field::height); ++i)
+    for (int j = 0; j < static_cast<int>(Field::width); ++j)
+      gameField_[i][j] = other.gameField_[i][j];
 
-  for (int i = 0; i < heightField; ++i) delete[] gameField_[i];
-  delete[] gameField_;
+  state_ = other.state_;
+  gameInfo_ = other.gameInfo_;
+  gameInfo_.field = gameField_;
+  score_ = other.score_;
+  high_score_ = other.high_score_;
+  level_ = other.level_;
+  snake_ = other.snake_;
+  apple_ = other.apple_;
+  key_ = other.key_;
+  lastKey_ = other.lastKey_;
+  gameOver_ = other.gameOver_;
+  hold_counter = other.hold_counter;
+  walls_ = other.walls_;
+  occupied_ = other.occupied_;
+  freeCells_ = other.freeCells_;
+  freeSlots_ = other.freeSlots_;
+  freeCount_ = other.freeCount_;
+  records_ = other.records_;
+  persistent_ = other.persistent_;
+  started_ = other.started_;
+  rng_ = other.rng_;
+  seed_ = other.seed_;
+
+  DeltaTrackerCopy(&tracker_, &other.tracker_);
+
+  return *this;
 }
 
 /**
@@ -177,6 +295,9 @@ void SnakeModel::resetGameInfo() {
  */
 void SnakeModel::startGame() {
   gameOver_ = false;
+  started_ = LeaderboardNow();
+
+  putSnake();
 
   gameInfo_.high_score = high_score_;
   gameInfo_.score = score_;
@@ -198,10 +319,36 @@ void SnakeModel::resetGame() {
   gameInfo_.speed = defineTime(level_);
 
   clearGameField();
+  resetCells();
   snake_.reset();
   apple_ = {4, 7};
 }
 
+/**
+ * @brief Record the finished game in the leaderboard
+ *
+ * @details Games without points are not recorded
+ */
+void SnakeModel::recordGame() {
+  if (!persistent_ || records_ == nullptr || score_ <= 0) return;
+
+  TraceScope trace("recordGame");
+  LeaderboardEntry entry;
+
+  LeaderboardEntryInit(&entry, score_, level_, 0, LeaderboardNow() - started_);
+  PersistRecord(records_, LeaderboardSnake, &entry);
+}
+
+/**
+ * @brief Save the high score of the game
+ * @param high_score High score
+ *
+ * @details Games that are not persistent are not saved
+ */
+void SnakeModel::saveScore(int high_score) {
+  if (persistent_) saveHighScore("records/snake", high_score);
+}
+
 /**
  * @brief User input accepts a user action as input
  * @param action User action
@@ -211,12 +358,14 @@ void SnakeModel::resetGame() {
  * @details Is the entry point into the game logic
  */
 void SnakeModel::userInput(UserAction_t action, bool hold) {
+  TraceScope trace("SnakeModel::userInput");
+
   for (int i = 0, iterations_num = 1; i < iterations_num; ++i) {
     switch (state_) {
       case State::Launch:
 
         if (action == UserAction_t::Terminate) {
-          saveHighScore("records/records", high_score_);
+          saveScore(high_score_);
           return;
         }
 
@@ -229,9 +378,15 @@ void SnakeModel::userInput(UserAction_t action, bool hold) {
 
       case State::Spawn:
 
-        removeSnake();
-        putSnake();
-        spawnApple();
+        putHead();
+
+        if (!spawnApple()) {
+          saveScore(high_score_);
+          recordGame();
+          state_ = State::Win;
+          break;
+        }
+
         putApple();
         state_ = State::Moving;
         break;
@@ -249,12 +404,6 @@ void SnakeModel::userInput(UserAction_t action, bool hold) {
           appleEating();
           state_ = State::Spawn;
           iterations_num++;
-          if (snake_.size() >= 200) {
-            saveHighScore("records/records", score_);
-            state_ = State::Win;
-            break;
-          }
-          state_ = State::Spawn;
           break;
         }
 
@@ -265,6 +414,7 @@ void SnakeModel::userInput(UserAction_t action, bool hold) {
 
       case State::GameOver:
 
+        recordGame();
         resetGame();
         state_ = State::Launch;
         break;
@@ -311,7 +461,8 @@ void SnakeModel::actionProcessing(UserAction_t action, bool hold) {
       gameInfo_.pause = !gameInfo_.pause;
       return;
     case UserAction_t::Terminate:
-      saveHighScore("records/records", high_score_);
+      saveScore(high_score_);
+      recordGame();
       return;
     case UserAction_t::Start:
       break;
@@ -326,11 +477,15 @@ void SnakeModel::actionProcessing(UserAction_t action, bool hold) {
 
   if (hold_counter > 2 && hold_counter % 6 != 0) return;
 
-  removeSnake();
-  snake_.move();
+  Point vacated;
+
+  if (snake_.move(vacated)) {
+    setCell(vacated, ' ');
+    vacate(vacated);
+  }
 
   if (!isCollision())
-    putSnake();
+    putHead();
   else
     state_ = State::Attaching;
 }
@@ -344,6 +499,19 @@ void SnakeModel::clearGameField() {
 
   for (int i = 0; i < heightField - 1; ++i)
     std::fill(gameField_[i] + 1, gameField_[i] + widthField - 1, ' ');
+
+  DeltaTouchRows(&tracker_, (1u << (heightField - 1)) - 1);
+}
+
+/**
+ * @brief Write a cell of the field
+ * @param point Cell
+ * @param value New value
+ */
+void SnakeModel::setCell(const Point &point, int value) {
+  gameField_[point.y][point.x] = value;
+
+  DeltaTouchRows(&tracker_, 1u << point.y);
 }
 
 /**
@@ -359,11 +527,7 @@ bool SnakeModel::isAppleCollision() {
  * @return True if there is a wall collision
  */
 bool SnakeModel::isWallCollision() {
-  int heightField = static_cast<int>(Field::height);
-  int widthField = static_cast<int>(Field::width);
-
-  return (snake_[0].x < 1 || snake_[0].x > widthField - 2) ||
-         (snake_[0].y < 0 || snake_[0].y > heightField - 2);
+  return walls_.test(cellIndex(snake_[0]));
 }
 
 /**
@@ -371,10 +535,7 @@ bool SnakeModel::isWallCollision() {
  * @return True if there is an inner collision
  */
 bool SnakeModel::isInnerCollision() {
-  for (int i = 1; i < snake_.size(); ++i)
-    if (snake_[0].y == snake_[i].y && snake_[0].x == snake_[i].x) return true;
-
-  return false;
+  return occupied_.test(cellIndex(snake_[0]));
 }
 
 /**
@@ -388,54 +549,61 @@ bool SnakeModel::isCollision() {
  * @brief Put snake on the field
  */
 void SnakeModel::putSnake() {
-  for (int i = 1; i < snake_.size(); ++i)
-    gameField_[snake_[i].y][snake_[i].x] = FigureSymbol::FigureSym + 3;
+  for (int i = 1; i < snake_.size(); ++i) {
+    setCell(snake_[i], FigureSymbol::FigureSym + 3);
+    occupy(snake_[i]);
+  }
 
-  gameField_[snake_[0].y][snake_[0].x] =
-      FigureSymbol::FigureSym + 6;  // light green
+  occupy(snake_[0]);
+
+  setCell(snake_[0], FigureSymbol::FigureSym + 6);  // light green
+}
+
+/**
+ * @brief Put the new head on the field and turn the old one into body
+ */
+void SnakeModel::putHead() {
+  if (snake_.size() > 1) setCell(snake_[1], FigureSymbol::FigureSym + 3);
+
+  occupy(snake_[0]);
+
+  setCell(snake_[0], FigureSymbol::FigureSym + 6);  // light green
 }
 
 /**
  * @brief Remove snake from the field
  */
 void SnakeModel::removeSnake() {
-  for (int i = 0; i < snake_.size(); ++i)
-    gameField_[snake_[i].y][snake_[i].x] = ' ';
+  for (int i = 0; i < snake_.size(); ++i) setCell(snake_[i], ' ');
+
+  resetCells();
 }
 
 /**
  * @brief Put apple on the field
  */
 void SnakeModel::putApple() {
-  gameField_[apple_.y][apple_.x] = FigureSymbol::FigureSym + 1;
+  setCell(apple_, FigureSymbol::FigureSym + 1);
 }
 
 /**
  * @brief Remove apple from the field
  */
-void SnakeModel::removeApple() { gameField_[apple_.y][apple_.x] = ' '; }
+void SnakeModel::removeApple() { setCell(apple_, ' '); }
 
 /**
  * @brief Spawn apple new position
+ * @return False if there is no free cell left
  */
-void SnakeModel::spawnApple() {
-  int heightField = static_cast<int>(Field::height);
-  int widthField = static_cast<int>(Field::width);
+bool SnakeModel::spawnApple() {
+  if (freeCount_ == 0) return false;
 
-  Point freeSpace[210] = {0, 0};
-  int freeSpaceCount = 0;
+  int widthField = static_cast<int>(Field::width);
+  int cell = freeCells_[RandomBelow(&rng_, freeCount_)];
 
-  for (int i = 0; i < heightField - 1; ++i)
-    for (int j = 1; j < widthField - 1; ++j) {
-      if (gameField_[i][j] == ' ') {
-        freeSpace[freeSpaceCount].x = j;
-        freeSpace[freeSpaceCount].y = i;
-        freeSpaceCount++;
-      }
-    }
+  apple_ = {cell / widthField - 1, cell % widthField};
 
-  int randomIndex = rand() % freeSpaceCount;
-  apple_ = freeSpace[randomIndex];
+  return true;
 }
 
 /**
@@ -496,6 +664,15 @@ bool SnakeModel::isTurn(UserAction_t action) {
  */
 GameInfo_t SnakeModel::updateCurrentState() { return gameInfo_; }
 
+/**
+ * @brief Changes of the game since the previous call
+ * @return Changed cells and numbers
+ * @see FrameDelta
+ */
+const FrameDelta &SnakeModel::updateFrameDelta() {
+  return *DeltaCollect(&tracker_, &gameInfo_);
+}
+
 /**
  * @brief Set key for cuurent input
  * @param key Input key
@@ -515,6 +692,131 @@ int SnakeModel::getLastKey() { return lastKey_; }
  */
 State SnakeModel::getState() { return gameOver_ ? State::GameOver : state_; }
 
+/**
+ * @brief Seed the random generator of the game
+ * @param seed Seed
+ *
+ * @details The same seed and the same input give the same game
+ */
+void SnakeModel::setSeed(uint64_t seed) {
+  seed_ = seed;
+
+  RandomSeed(&rng_, seed);
+}
+
+/**
+ * @brief Get the seed of the random generator
+ * @return Seed, random unless set
+ */
+uint64_t SnakeModel::getSeed() { return seed_; }
+
+/**
+ * @brief Choose the randomizer of the pieces
+ * @param bagged Ignored, the apples are always drawn uniformly
+ */
+void SnakeModel::setBag(bool bagged) { (void)bagged; }
+
+/**
+ * @brief Set the leaderboard of finished games
+ * @param path Path to the leaderboard file, nullptr to skip
+ */
+void SnakeModel::setRecords(const char *path) { records_ = path; }
+
+/**
+ * @brief Keep the results of finished games
+ * @param persistent False skips the high score and the leaderboard
+ */
+void SnakeModel::setPersistent(bool persistent) { persistent_ = persistent; }
+
+/**
+ * @brief Take the high score of the player from the records
+ */
+void SnakeModel::loadHighScore() {
+  high_score_ = getHighScore("records/snake");
+  gameInfo_.high_score = high_score_;
+}
+
+/**
+ * @brief Copy the game
+ * @return Independent game in the same state
+ *
+ * @details Replays keep snapshots to seek without starting over
+ */
+std::unique_ptr<IModel> SnakeModel::snapshot() {
+  return std::make_unique<SnakeModel>(*this);
+}
+
+/**
+ * @brief Take the state of a snapshot
+ * @param snapshot Snapshot of a game of the same type
+ */
+void SnakeModel::restore(const IModel &snapshot) {
+  *this = dynamic_cast<const SnakeModel &>(snapshot);
+}
+
+/**
+ * @brief Mark a cell as taken by the snake
+ * @param point Cell
+ */
+void SnakeModel::occupy(const Point &point) {
+  int cell = cellIndex(point);
+
+  if (occupied_.test(cell)) return;
+
+  occupied_.set(cell);
+
+  int slot = freeSlots_[cell];
+
+  if (slot < 0) return;
+
+  int last = freeCells_[--freeCount_];
+
+  freeCells_[slot] = last;
+  freeSlots_[last] = slot;
+  freeSlots_[cell] = -1;
+}
+
+/**
+ * @brief Mark a cell as left by the snake
+ * @param point Cell
+ */
+void SnakeModel::vacate(const Point &point) {
+  int cell = cellIndex(point);
+
+  if (!occupied_.test(cell)) return;
+
+  occupied_.reset(cell);
+
+  if (walls_.test(cell)) return;
+
+  freeSlots_[cell] = freeCount_;
+  freeCells_[freeCount_++] = cell;
+}
+
+/**
+ * @brief Mark every playable cell as free
+ */
+void SnakeModel::resetCells() {
+  occupied_.reset();
+  freeSlots_.fill(-1);
+  freeCount_ = 0;
+
+  for (int cell = 0; cell < cells; ++cell)
+    if (!walls_.test(cell)) {
+      freeSlots_[cell] = freeCount_;
+      freeCells_[freeCount_++] = cell;
+    }
+}
+
+/**
+ * @brief Bit of a cell in the occupancy sets
+ * @param point Cell, one step outside the field at most
+ * @return Bit number
+ */
+int SnakeModel::cellIndex(const Point &point) {
+  return (point.y + 1) * static_cast<int>(Field::width) + point.x;
+}
+
 /**
  * @brief Create new matrix
  * @param height Height
@@ -522,9 +824,9 @@ State SnakeModel::getState() { return gameOver_ ? State::GameOver : state_; }
  * @return New matrix
  */
 int **SnakeModel::newMatrix(int height, int width) {
-  int **field = new int *[height];
+  int **field = nullptr;
 
-  for (int i = 0; i < height; ++i) field[i] = new int[width];
+  if (CreateMatrix(height, width, &field)) throw std::bad_alloc();
 
   return field;
 }
@@ -533,44 +835,28 @@ int **SnakeModel::newMatrix(int height, int width) {
  * @brief Save high score to the file
  * @param path Path to the file
  * @param high_score High score
+ * @see PersistHighScore
+ *
+ * @details The file is written by the persistence worker
  */
 void saveHighScore(const char *path, int high_score) {
-  mkdir("records", 0777);
-
-  std::ofstream file(path);
-
-  if (!file.is_open()) return;
-
-  file << "HighScore = " << high_score;
+  TraceScope trace("saveHighScore");
 
-  file.close();
+  PersistHighScore(path, high_score);
 }
 
 /**
  * @brief Get high score from the file
  * @param path Path to the file
  * @return High score
+ * @see ScoreStoreMigrate
+ *
+ * @details A missing file takes the score of the file shared by the games
+ *          in earlier versions
  */
 int getHighScore(const char *path) {
-  std::ifstream file(path);
-
-  if (!file.is_open()) {
-    return 0;
-  }
-
-  std::string line;
-  int high_score = 0;
-
-  while (std::getline(file, line)) {
-    if (line.find("HighScore = ") != std::string::npos) {
-      int n = sscanf(line.c_str(), "HighScore = %d", &high_score);
-      if (n < 1) high_score = 0;
-
-      break;
-    }
-  }
+  TraceScope trace("getHighScore");
 
-  file.close();
-  return high_score;
+  return ScoreStoreMigrate(path, ScoreStoreLegacyPath);
 }
 }  // namespace s21
\ No newline at end of file
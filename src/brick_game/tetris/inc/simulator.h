@@ -0,0 +1,65 @@
+/*!
+    @file
+    @brief Headless Tetris simulator
+*/
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdint.h>
+
+#include "tetris.h"
+
+/*!
+    @brief Headless Tetris session
+
+    Advances the engine one tick per action without any terminal,
+    window or timer, restarting the game by itself after game over
+*/
+typedef struct {
+  TetrisContext ctx;  ///< Simulated game
+  uint64_t ticks;     ///< Ticks simulated so far
+  uint64_t lines;     ///< Rows removed so far
+  uint64_t games;     ///< Games finished so far
+
+} TetrisSimulator;
+
+/*!
+    @brief Initialize the simulator
+    @param sim Simulator
+*/
+void TetrisSimInit(TetrisSimulator *sim);
+
+/*!
+    @brief Release the simulator
+    @param sim Simulator
+*/
+void TetrisSimDestroy(TetrisSimulator *sim);
+
+/*!
+    @brief Advance the game by n ticks
+    @param sim Simulator
+    @param actions Action of every tick
+    @param n Number of ticks
+    @return Rows removed during these ticks
+*/
+int TetrisSimStep(TetrisSimulator *sim, const UserAction_t *actions, int n);
+
+/*!
+    @brief Choose the randomizer of the figures
+    @param sim Simulator
+    @param bagged Non-zero for the 7-bag, zero for uniform draws
+
+    The game is seeded again with its seed, so the next figure already
+    comes from the chosen randomizer
+*/
+void TetrisSimSetBag(TetrisSimulator *sim, int bagged);
+
+/*!
+    @brief Key the frontend would send along with an action
+    @param ctx Game context
+    @param action User action
+    @return Pressed key, -1 for a gravity tick
+*/
+int TetrisSimKey(const TetrisContext *ctx, UserAction_t action);
+
+#endif
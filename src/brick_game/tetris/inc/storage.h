@@ -5,12 +5,49 @@
 #ifndef STORAGE_H
 #define STORAGE_H
 
-/*!
-    @brief Get index of the figure
-    @param x X coordinate
-    @param y Y coordinate
-    @return presence of the figure
-*/
-int getFigureIndex(int x, int y);
+#include <stdint.h>
+
+/// Figure table dimensions
+typedef enum {
+
+  FiguresCount = 7,    ///< Number of figures
+  RotationsCount = 4,  ///< Rotation states of every figure
+  KickTests = 5,       ///< Maximum wall kick tests of a rotation
+  SpawnColumn = 4      ///< Field column of the preview left edge
+
+} FigureTable;
+
+/// Cell offset from the figure pivot
+typedef struct {
+  int8_t row;  ///< Row offset
+  int8_t col;  ///< Column offset
+
+} FigureCell;
+
+/// Rotation state of a figure
+typedef struct {
+  FigureCell cells[4];  ///< Cells relative to the pivot
+  int8_t top;           ///< Top row relative to the pivot
+  int8_t left;          ///< Left column relative to the pivot
+  int8_t height;        ///< Number of rows the figure spans
+  uint16_t masks[4];    ///< Row masks from the top row, bit 0 is left column
+
+} FigureRotation;
+
+/// Wall kick tests of a figure
+typedef struct {
+  int8_t count;                 ///< Number of tests
+  FigureCell tests[KickTests];  ///< Pivot shifts, tried in order
+
+} FigureKicks;
+
+/// Rotation states of all figures
+extern const FigureRotation figureRotations[FiguresCount][RotationsCount];
+
+/// Wall kick tests of all figures
+extern const FigureKicks figureKicks[FiguresCount];
+
+/// Pivot of every figure inside the 2x4 preview
+extern const FigureCell figurePivots[FiguresCount];
 
-#endif
\ No newline at end of file
+#endif
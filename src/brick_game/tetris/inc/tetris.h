@@ -5,24 +5,212 @@
 #ifndef TETRIS_H
 #define TETRIS_H
 
+#include <stdint.h>
+
 #include "../../../components/GameInfo/GameInfo.h"
+#include "../../../components/framedelta/framedelta.h"
+#include "../../../components/leaderboard/leaderboard.h"
+#include "../../../components/random/random.h"
+#include "../../../components/trace/trace.h"
 #include "../../bg_enums.h"
 #include "storage.h"
 
+/// Row occupancy masks, bit j is column j of the field
+typedef enum {
+
+  RowFullMask = 0x07FE,  ///< Playable cells of a row
+  RowWallMask = 0xF801,  ///< Side walls and everything past the right one
+  RowFloorMask = 0xFFFF  ///< Bottom border
+
+} RowMasks;
+
 /// Structure of game
 typedef struct {
   State state;  ///< Current state of the game
 
-  int clicks;    ///< Number of clicks
   int blocking;  ///< Blocking figure shifting
-  int key;       ///< Pressed key
+  int key;       ///< Pressed key, -1 for a gravity tick
   int last_key;  ///< Last pressed key
-  int move;      ///< Figure moving flag
+  int drop;      ///< Soft drop flag
 
 } TetrisGame;
 
 /*!
-        @brief Tetris backend initialization
+    @brief Bitboard of the attached blocks
+
+    Color rows are reached through slots, so removing lines only moves
+    the masks and the slot numbers, never the colors themselves
+*/
+typedef struct {
+  uint16_t rows[FieldRows];              ///< Occupancy mask per row
+  uint8_t slots[FieldRows];              ///< Color row of every field row
+  uint8_t colors[FieldRows][FieldCols];  ///< Color plane of the blocks
+
+} TetrisBoard;
+
+/// Falling figure
+typedef struct {
+  int type;      ///< Figure number
+  int rotation;  ///< Rotation state
+  int row;       ///< Pivot row
+  int col;       ///< Pivot column
+  int color;     ///< Figure color
+  int active;    ///< Figure is on the field
+
+} TetrisFigure;
+
+/*!
+    @brief Tetris game context
+
+    Holds everything a single Tetris session needs, so any number of
+    independent games can run side by side
+*/
+typedef struct {
+  GameInfo_t gameInfo;   ///< Game information shared with the view
+  TetrisGame game;       ///< Finite-state machine data
+  TetrisBoard board;     ///< Attached blocks, the source of truth
+  TetrisFigure figure;   ///< Falling figure
+  uint32_t cleared;      ///< Rows removed by the last attached figure
+  int dirty;             ///< gameInfo.field is behind the board
+  uint32_t touched;      ///< Board rows changed since the field was built
+  uint32_t changed;      ///< Board rows changed since TetrisTakeChangedRows
+  uint32_t drawn;        ///< Rows of the figure drawn on the field
+  DeltaTracker tracker;  ///< Changes not reported to the frame delta yet
+  int lines;             ///< Lines cleared in this game
+  uint64_t started;      ///< Start of this game, LeaderboardNow
+  const char *records;   ///< Leaderboard of finished games, NULL for none
+  int persistent;        ///< High score and finished games are saved
+  Random rng;            ///< Generator of the figures and colors
+  uint64_t seed;         ///< Seed of the generator
+  RandomBag bag;         ///< Bag of the figures
+  int bagged;            ///< Figures are drawn from the bag
+
+} TetrisContext;
+
+/*!
+    @brief Initialize the game context
+    @param ctx Game context
+*/
+void TetrisContextInit(TetrisContext *ctx);
+
+/*!
+    @brief Release the game context
+    @param ctx Game context
+*/
+void TetrisContextDestroy(TetrisContext *ctx);
+
+/*!
+    @brief Copy the game context into another one
+    @param dst Initialized game context
+    @param src Game context to copy
+
+    The copy owns its matrices and goes on independently
+*/
+void TetrisContextCopy(TetrisContext *dst, const TetrisContext *src);
+
+/*!
+    @brief Initialize the game state
+    @param ctx Game context
+*/
+void GameStateInit(TetrisContext *ctx);
+
+/*!
+    @brief Initialize game information
+    @param ctx Game context
+*/
+void GameInfoInit(TetrisContext *ctx);
+
+/*!
+    @brief Update current state
+    @param ctx Game context
+    @return Copied structure of game information
+
+    The field matrix is rebuilt from the board only when it is stale
+*/
+GameInfo_t TetrisUpdateCurrentState(TetrisContext *ctx);
+
+/*!
+    @brief Collect the changes since the previous delta
+    @param ctx Game context
+    @return Delta owned by the context
+*/
+const FrameDelta *TetrisUpdateFrameDelta(TetrisContext *ctx);
+
+/*!
+    @brief Get last pressed key
+    @param ctx Game context
+    @return Last pressed key
+*/
+int TetrisGetLastKey(const TetrisContext *ctx);
+
+/*!
+    @brief Get current state
+    @param ctx Game context
+    @return Current state
+*/
+State TetrisGetState(const TetrisContext *ctx);
+
+/*!
+    @brief Control of the game logic
+    @param ctx Game context
+    @param action User action
+    @param hold Flag of hold
+*/
+void TetrisUserInput(TetrisContext *ctx, UserAction_t action, bool hold);
+
+/*!
+    @brief Set new pressed key
+    @param ctx Game context
+    @param new_key New pressed key
+*/
+void TetrisSetKey(TetrisContext *ctx, int new_key);
+
+/*!
+    @brief Get rows removed by the last attached figure
+    @param ctx Game context
+    @return Bit i is set if row i of the field was removed
+*/
+uint32_t TetrisGetClearedRows(const TetrisContext *ctx);
+
+/*!
+    @brief Take the board rows changed since the previous call
+    @param ctx Game context
+    @return Bit i is set if row i of the board changed
+
+    Lets headless users keep their own copy of the board without
+    building the field
+*/
+uint32_t TetrisTakeChangedRows(TetrisContext *ctx);
+
+/*!
+    @brief Seed the generator of the figures
+    @param ctx Game context
+    @param seed Seed
+
+    The next figure is drawn again, so the same seed and input give
+    the same game
+*/
+void TetrisSetSeed(TetrisContext *ctx, uint64_t seed);
+
+/*!
+    @brief Get the seed of the generator
+    @param ctx Game context
+    @return Seed
+*/
+uint64_t TetrisGetSeed(const TetrisContext *ctx);
+
+/*!
+    @brief Choose the randomizer of the figures
+    @param ctx Game context
+    @param bagged Non-zero for the 7-bag, zero for uniform draws
+
+    Takes effect after the next figure, set it before the seed to
+    reproduce a game
+*/
+void TetrisSetBag(TetrisContext *ctx, int bagged);
+
+/*!
+    @brief Tetris backend initialization
 */
 void TetrisGameInit();
 
@@ -32,6 +220,12 @@ void TetrisGameInit();
 */
 GameInfo_t updateCurrentState();
 
+/*!
+    @brief Collect the changes since the previous delta
+    @return Delta owned by the default context
+*/
+const FrameDelta *updateFrameDelta();
+
 /*!
     @brief Get last pressed key
     @return Last pressed key
@@ -63,155 +257,205 @@ void userInput(UserAction_t action, bool hold);
 
 /*!
     @brief Process user input
+    @param ctx Game context
     @param action User action
     @param hold Hold action
 */
-void actionProcessing(UserAction_t action, bool hold);
+void actionProcessing(TetrisContext *ctx, UserAction_t action, bool hold);
 
 /*!
     @brief Processing status after user input
+    @param ctx Game context
     @param action User action
 */
-int StatusProcessing(UserAction_t action);
+int StatusProcessing(TetrisContext *ctx, UserAction_t action);
 
 /*!
     @brief Processing shifting and state after moving
+    @param ctx Game context
 */
-void ShiftingProcessing();
+void ShiftingProcessing(TetrisContext *ctx);
 
 /*!
-    @brief Removing the current figure from the field
-    @param axis Axis
-    @param term Term
-
-    Removing the current figure from the field and shifting it to a term.
-    Also color field clearing
+    @brief Empty the board leaving only the borders
+    @param board Board
 */
-void ResettingOldFigure(int axis, int term);
+void BoardInit(TetrisBoard *board);
 
 /*!
-    @brief Checking for cell accessibility after shift
-    @return Count of free cells
+    @brief Build the field matrix from the board and the falling figure
+    @param ctx Game context
+
+    Only rows whose blocks changed or that hold the old or the new
+    position of the figure are rebuilt
 */
-int CheckingFreePosition();
+void MaterializeField(TetrisContext *ctx);
 
 /*!
-    @brief Returning the figure back
-    @param axis Axis
-    @param term Term
+    @brief Rows covered by the figure
+    @param figure Figure
+    @return Bit i is set if the figure has a block in row i
+*/
+uint32_t FigureRows(const TetrisFigure *figure);
 
-    If the field spaces are already occupied, then return the figure back
+/*!
+    @brief Checking the figure against the board
+    @param board Board
+    @param figure Figure
+    @return 1 if the figure overlaps blocks or borders
 */
-void ReturnFigureBack(int axis, int term);
+int FigureCollides(const TetrisBoard *board, const TetrisFigure *figure);
 
 /*!
-    @brief Transfer figure to field and color to color field
+    @brief Shifting the falling figure if there is room
+    @param ctx Game context
+    @param rows Rows term
+    @param cols Columns term
+    @return 1 if the figure was shifted
 */
-void TransferFigureToField();
+int ShiftFigure(TetrisContext *ctx, int rows, int cols);
 
 /*!
-    @brief Assigning symbol matrix elements to spaces
-    @param field Field
-    @param row1 First row
-    @param row2 Last row
-    @param col1 First column
-    @param col2 Last column
+    @brief Attach the falling figure to the board
+    @param ctx Game context
 */
-void ClearField(int **field, int row1, int row2, int col1, int col2);
+void LockFigure(TetrisContext *ctx);
 
 /*!
     @brief Attaching stage
+    @param ctx Game context
 */
-void AttachingStage();
+void AttachingStage(TetrisContext *ctx);
 
 /*!
     @brief Shifting a piece down the field onto a cell
+    @param ctx Game context
 */
-void FigureDown();
+void FigureDown(TetrisContext *ctx);
 
 /*!
     @brief Takes a new figure from figures.c
+    @param ctx Game context
 
-    Also color field filling and setting the next figure and her color
+    Also setting the next figure and her color
 */
-void DropFigure();
+void DropFigure(TetrisContext *ctx);
 
 /*!
     @brief Move horizontal
+    @param ctx Game context
     @param side Left or right
 */
-void MoveHorizontal(char *side);
+void MoveHorizontal(TetrisContext *ctx, char *side);
 
 /*!
-    @brief Rotating a figure via the rotation matrix
+    @brief Rotating a figure to its next rotation state
+    @param ctx Game context
+
+    Wall kick tests of the figure are tried in order until one fits
 */
-void Rotate();
+void Rotate(TetrisContext *ctx);
 
 /*!
     @brief Set next figure
+    @param ctx Game context
     @param next Next figure
 */
-void SetNextFigure(int next);
+void SetNextFigure(TetrisContext *ctx, int next);
 
 /*!
     @brief Get next figure
+    @param ctx Game context
     @return Next figure
 */
-int GetNextFigure();
+int GetNextFigure(const TetrisContext *ctx);
+
+/*!
+    @brief Draw the number of a new figure
+    @param ctx Game context
+    @return Figure number
+*/
+int RandomFigure(TetrisContext *ctx);
 
 /*!
     @brief Set current figure
+    @param ctx Game context
     @param current Current figure
 */
-void SetCurrentFigure(int next);
+void SetCurrentFigure(TetrisContext *ctx, int current);
 
 /*!
     @brief Get current figure
+    @param ctx Game context
     @return Current figure
 */
-int GetCurrentFigure();
+int GetCurrentFigure(const TetrisContext *ctx);
 
 /*!
     @brief Restarting the game after game over
+    @param ctx Game context
 */
-void Restart();
+void Restart(TetrisContext *ctx);
 
 /*!
     @brief Checking the end of the game after attaching
+    @param ctx Game context
 */
-void GameOverCheck();
+void GameOverCheck(TetrisContext *ctx);
 
 /*!
     @brief Removing filled lines
+    @param ctx Game context
+    @return Bit i is set if row i of the field was removed
 
     Replenishment of points after the destruction of lines
-    and shifting the field down a cell
+    and shifting the field down in a single pass
 */
-void RemovingFilledLines();
-
-/*!
-    @brief Shifting the field down a cell
-*/
-void FieldDown(int row);
+uint32_t RemovingFilledLines(TetrisContext *ctx);
 
 /*!
     @brief Saving the high score to the file
+    @param ctx Game context
     @param path Path to the file
+
+    Games that are not persistent are not saved
 */
-void SaveHighScore(const char *path);
+void SaveHighScore(const TetrisContext *ctx, const char *path);
 
 /*!
     @brief Getting the high score from the file
     @param path Path to the file
+
+    A missing file takes the score of the file shared by the games
+    in earlier versions
 */
 int GetHighScore(const char *path);
 
+/*!
+    @brief Taking the high score of the player from the file
+    @param ctx Game context
+
+    Only live games call it, simulated and replayed games start from
+    zero and never read the records
+*/
+void TetrisLoadHighScore(TetrisContext *ctx);
+
+/*!
+    @brief Recording the finished game in the leaderboard
+    @param ctx Game context
+    @param path Path to the leaderboard file, NULL to skip
+
+    Games that are not persistent are not recorded
+*/
+void RecordGame(const TetrisContext *ctx, const char *path);
+
 /*!
     @brief Increase in points from destroying lines
+    @param ctx Game context
 
     Also updating the record and increasing the level with speed
 */
-void ProcessingRemovedLines(int removed_lines);
+void ProcessingRemovedLines(TetrisContext *ctx, int removed_lines);
 
 /*!
     @brief Define tetris time
@@ -225,4 +469,4 @@ int defineTetrisTime(int level);
 */
 void setKey(int new_key);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,113 @@
+/*!
+    @file
+    @brief Headless Tetris simulator implementation
+*/
+#include "../inc/simulator.h"
+
+#include <stddef.h>
+
+/*!
+    @brief Initialize the simulator
+    @param sim Simulator
+
+    Simulated games are not saved
+*/
+void TetrisSimInit(TetrisSimulator *sim) {
+  TetrisContextInit(&sim->ctx);
+
+  sim->ctx.records = NULL;
+  sim->ctx.persistent = 0;
+
+  sim->ticks = 0;
+  sim->lines = 0;
+  sim->games = 0;
+}
+
+/*!
+    @brief Release the simulator
+    @param sim Simulator
+*/
+void TetrisSimDestroy(TetrisSimulator *sim) { TetrisContextDestroy(&sim->ctx); }
+
+/*!
+    @brief Choose the randomizer of the figures
+    @param sim Simulator
+    @param bagged Non-zero for the 7-bag, zero for uniform draws
+
+    The game is seeded again with its seed, so the next figure already
+    comes from the chosen randomizer
+*/
+void TetrisSimSetBag(TetrisSimulator *sim, int bagged) {
+  TetrisSetBag(&sim->ctx, bagged);
+  TetrisSetSeed(&sim->ctx, TetrisGetSeed(&sim->ctx));
+}
+
+/*!
+    @brief Advance the game by n ticks
+    @param sim Simulator
+    @param actions Action of every tick
+    @param n Number of ticks
+    @return Rows removed during these ticks
+
+    Start is a plain gravity tick while the game runs and starts
+    a new game otherwise. Terminate is ignored, so nothing
+    is ever written to disk
+*/
+int TetrisSimStep(TetrisSimulator *sim, const UserAction_t *actions, int n) {
+  TetrisContext *ctx = &sim->ctx;
+
+  int lines = 0;
+
+  for (int i = 0; i < n; i++) {
+    UserAction_t action = actions[i] == Terminate ? Start : actions[i];
+
+    int key = TetrisSimKey(ctx, action);
+    bool hold = key != -1 && key == TetrisGetLastKey(ctx);
+    State before = TetrisGetState(ctx);
+
+    ctx->cleared = 0;
+
+    TetrisSetKey(ctx, key);
+    TetrisUserInput(ctx, action, hold);
+
+    if (ctx->cleared) lines += __builtin_popcount(ctx->cleared);
+
+    if (before != GameOver && TetrisGetState(ctx) == GameOver) sim->games++;
+  }
+
+  sim->ticks += n;
+  sim->lines += lines;
+
+  return lines;
+}
+
+/*!
+    @brief Key the frontend would send along with an action
+    @param ctx Game context
+    @param action User action
+    @return Pressed key, -1 for a gravity tick
+*/
+int TetrisSimKey(const TetrisContext *ctx, UserAction_t action) {
+  State state = TetrisGetState(ctx);
+
+  switch (action) {
+    case Start:
+      return (state == Launch || state == GameOver) ? ENTER : -1;
+    case Pause:
+      return PAUSE;
+    case Terminate:
+      return QUIT;
+    case Left:
+      return ArrowLeft;
+    case Right:
+      return ArrowRight;
+    case Up:
+      return ArrowUp;
+    case Down:
+      return ArrowDown;
+    case Action:
+      return ACTION;
+    default:
+      return -1;
+  }
+}
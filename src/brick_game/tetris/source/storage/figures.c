@@ -1,38 +1,140 @@
 /*!
     @file
     @brief Tetris figures storage
+
+    Every rotation state is generated by the preprocessor from the base
+    cells of a figure, so the tables are constant data and rotating or
+    spawning a figure is a plain lookup
 */
 #include "../../inc/storage.h"
 
-static int figures[14][5] = {
+/// Row of a pivot-relative cell after k quarter turns
+#define TURN_ROW(k, r, c) \
+  ((k) == 0 ? (r) : (k) == 1 ? -(c) : (k) == 2 ? -(r) : (c))
 
-    {0, 1, 1, 1, 1},  // ####
-    {0, 0, 0, 0, 0},  //
+/// Column of a pivot-relative cell after k quarter turns
+#define TURN_COL(k, r, c) \
+  ((k) == 0 ? (c) : (k) == 1 ? (r) : (k) == 2 ? -(c) : -(r))
 
-    {0, 0, 1, 0, 0},  //  #
-    {0, 1, 1, 1, 0},  // ###
+/// Turn a cell given as a single "r, c" argument
+#define TURN_ROW_OF(...) TURN_ROW(__VA_ARGS__)
+#define TURN_COL_OF(...) TURN_COL(__VA_ARGS__)
 
-    {0, 1, 0, 0, 0},  // #
-    {0, 1, 1, 1, 0},  // ###
+#define MIN2(a, b) ((a) < (b) ? (a) : (b))
+#define MAX2(a, b) ((a) > (b) ? (a) : (b))
+#define MIN4(a, b, c, d) MIN2(MIN2(a, b), MIN2(c, d))
+#define MAX4(a, b, c, d) MAX2(MAX2(a, b), MAX2(c, d))
 
-    {0, 0, 0, 1, 0},  //   #
-    {0, 1, 1, 1, 0},  // ###
+/// Apply F to the turned rows of all four cells
+#define ROWS4(F, k, r0, c0, r1, c1, r2, c2, r3, c3)                \
+  F(TURN_ROW(k, r0, c0), TURN_ROW(k, r1, c1), TURN_ROW(k, r2, c2), \
+    TURN_ROW(k, r3, c3))
 
-    {0, 1, 1, 0, 0},  // ##
-    {0, 1, 1, 0, 0},  // ##
+/// Apply F to the turned columns of all four cells
+#define COLS4(F, k, r0, c0, r1, c1, r2, c2, r3, c3)                \
+  F(TURN_COL(k, r0, c0), TURN_COL(k, r1, c1), TURN_COL(k, r2, c2), \
+    TURN_COL(k, r3, c3))
 
-    {0, 1, 1, 0, 0},  // ##
-    {0, 0, 1, 1, 0},  //  ##
+/// Bit of one turned cell inside row m of the mask
+#define CELL_BIT(m, k, top, left, r, c) \
+  ((TURN_ROW(k, r, c) - (top) == (m)) << (TURN_COL(k, r, c) - (left)))
 
-    {0, 0, 1, 1, 0},  //  ##
-    {0, 1, 1, 0, 0}   // ##
+/// Row m of the mask of a turned figure
+#define ROW_MASK(m, k, r0, c0, r1, c1, r2, c2, r3, c3)                      \
+  (uint16_t)(CELL_BIT(m, k, ROWS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), \
+                      COLS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), r0,   \
+                      c0) |                                                 \
+             CELL_BIT(m, k, ROWS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), \
+                      COLS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), r1,   \
+                      c1) |                                                 \
+             CELL_BIT(m, k, ROWS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), \
+                      COLS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), r2,   \
+                      c2) |                                                 \
+             CELL_BIT(m, k, ROWS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), \
+                      COLS4(MIN4, k, r0, c0, r1, c1, r2, c2, r3, c3), r3,   \
+                      c3))
 
-};
+/// Pick one "r, c" cell out of the four
+#define CELL0(r0, c0, r1, c1, r2, c2, r3, c3) r0, c0
+#define CELL1(r0, c0, r1, c1, r2, c2, r3, c3) r1, c1
+#define CELL2(r0, c0, r1, c1, r2, c2, r3, c3) r2, c2
+#define CELL3(r0, c0, r1, c1, r2, c2, r3, c3) r3, c3
+
+/// Rotation state k of a figure given by its pivot-relative cells
+#define ROTATION(k, ...)                                                \
+  {                                                                     \
+    .cells = {{TURN_ROW_OF(k, CELL0(__VA_ARGS__)),                      \
+               TURN_COL_OF(k, CELL0(__VA_ARGS__))},                     \
+              {TURN_ROW_OF(k, CELL1(__VA_ARGS__)),                      \
+               TURN_COL_OF(k, CELL1(__VA_ARGS__))},                     \
+              {TURN_ROW_OF(k, CELL2(__VA_ARGS__)),                      \
+               TURN_COL_OF(k, CELL2(__VA_ARGS__))},                     \
+              {TURN_ROW_OF(k, CELL3(__VA_ARGS__)),                      \
+               TURN_COL_OF(k, CELL3(__VA_ARGS__))}},                    \
+    .top = ROWS4(MIN4, k, __VA_ARGS__),                                 \
+    .left = COLS4(MIN4, k, __VA_ARGS__),                                \
+    .height =                                                           \
+        ROWS4(MAX4, k, __VA_ARGS__) - ROWS4(MIN4, k, __VA_ARGS__) + 1,  \
+    .masks = {ROW_MASK(0, k, __VA_ARGS__), ROW_MASK(1, k, __VA_ARGS__), \
+              ROW_MASK(2, k, __VA_ARGS__), ROW_MASK(3, k, __VA_ARGS__)} \
+  }
+
+/// All rotation states of a figure
+#define FIGURE(...)                                        \
+  {                                                        \
+    ROTATION(0, __VA_ARGS__), ROTATION(1, __VA_ARGS__),    \
+        ROTATION(2, __VA_ARGS__), ROTATION(3, __VA_ARGS__) \
+  }
+
+/// Figure whose rotation states all look the same
+#define SQUARE(...)                                        \
+  {                                                        \
+    ROTATION(0, __VA_ARGS__), ROTATION(0, __VA_ARGS__),    \
+        ROTATION(0, __VA_ARGS__), ROTATION(0, __VA_ARGS__) \
+  }
 
 /*!
-    @brief Get index of the figure
-    @param x X coordinate
-    @param y Y coordinate
-    @return presence of the figure
+    Cells are given relative to the pivot the figure turns around,
+    the pivot itself is always the third cell
 */
-int getFigureIndex(int x, int y) { return figures[x][y]; }
\ No newline at end of file
+const FigureRotation figureRotations[FiguresCount][RotationsCount] = {
+
+    FIGURE(0, -2, 0, -1, 0, 0, 0, 1),  // ####
+
+    FIGURE(-1, 0, 0, -1, 0, 0, 0, 1),  //  #
+                                       // ###
+
+    FIGURE(-1, -1, 0, -1, 0, 0, 0, 1),  // #
+                                        // ###
+
+    FIGURE(-1, 1, 0, -1, 0, 0, 0, 1),  //   #
+                                       // ###
+
+    SQUARE(-1, 0, -1, 1, 0, 0, 0, 1),  // ##
+                                       // ##
+
+    FIGURE(-1, -1, -1, 0, 0, 0, 0, 1),  // ##
+                                        //  ##
+
+    FIGURE(-1, 1, -1, 2, 0, 0, 0, 1)  //  ##
+                                      // ##
+
+};
+
+const FigureKicks figureKicks[FiguresCount] = {
+
+    {5, {{0, 0}, {0, -1}, {0, 1}, {0, -2}, {0, 2}}},  // I
+    {3, {{0, 0}, {0, -1}, {0, 1}}},                   // T
+    {3, {{0, 0}, {0, -1}, {0, 1}}},                   // J
+    {3, {{0, 0}, {0, -1}, {0, 1}}},                   // L
+    {1, {{0, 0}}},                                    // O
+    {3, {{0, 0}, {0, -1}, {0, 1}}},                   // Z
+    {3, {{0, 0}, {0, -1}, {0, 1}}}                    // S
+
+};
+
+const FigureCell figurePivots[FiguresCount] = {
+
+    {0, 2}, {1, 1}, {1, 1}, {1, 1}, {1, 0}, {1, 1}, {1, 0}
+
+};
@@ -7,363 +7,514 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/stat.h>
 
 #include "../../../components/cmatrix/cmatrix.h"
+#include "../../../components/persist/persist.h"
+#include "../../../components/scorestore/scorestore.h"
 
-static GameInfo_t gameInfo;
-static TetrisGame game;
+/// Context behind the default-instance API
+static TetrisContext defaultContext;
 
 /*!
-  @brief Tetris backend initialization
+    @brief Initialize the game context
+    @param ctx Game context
 */
-void TetrisGameInit() {
-  game.state = Launch;
+void TetrisContextInit(TetrisContext *ctx) {
+  GameStateInit(ctx);
+  GameInfoInit(ctx);
+}
+
+/*!
+    @brief Release the game context
+    @param ctx Game context
+*/
+void TetrisContextDestroy(TetrisContext *ctx) {
+  if (ctx->gameInfo.field) RemoveMatrix(ctx->gameInfo.field, FieldRows);
+
+  if (ctx->gameInfo.next) RemoveMatrix(ctx->gameInfo.next, 4);
+
+  DeltaTrackerDestroy(&ctx->tracker);
+
+  ctx->gameInfo.field = NULL;
+  ctx->gameInfo.next = NULL;
+}
+
+/*!
+    @brief Copy the game context into another one
+    @param dst Initialized game context
+    @param src Game context to copy
 
-  game.clicks = 0;
+    The copy owns its matrices and goes on independently
+*/
+void TetrisContextCopy(TetrisContext *dst, const TetrisContext *src) {
+  int **field = dst->gameInfo.field, **next = dst->gameInfo.next;
+  int **shadow = dst->tracker.shadow;
 
-  game.blocking = 0;
+  *dst = *src;
 
-  game.key = 0;
+  dst->gameInfo.field = field;
+  dst->gameInfo.next = next;
+  dst->tracker.shadow = shadow;
+
+  for (int i = 0; i < FieldRows; i++)
+    for (int j = 0; j < FieldCols; j++)
+      field[i][j] = src->gameInfo.field[i][j];
 
-  game.last_key = -1;
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 6; j++) next[i][j] = src->gameInfo.next[i][j];
 
-  game.move = 0;
+  DeltaTrackerCopy(&dst->tracker, &src->tracker);
+}
+
+/*!
+    @brief Initialize the game state
+    @param ctx Game context
+*/
+void GameStateInit(TetrisContext *ctx) {
+  ctx->game.state = Launch;
+
+  ctx->game.blocking = 0;
+
+  ctx->game.key = 0;
+
+  ctx->game.last_key = -1;
+
+  ctx->game.drop = 0;
 }
 
 /*!
     @brief Update current state
+    @param ctx Game context
     @return Copied structure of game information
 */
-GameInfo_t updateCurrentState() { return gameInfo; }
+GameInfo_t TetrisUpdateCurrentState(TetrisContext *ctx) {
+  if (ctx->dirty) MaterializeField(ctx);
+
+  return ctx->gameInfo;
+}
+
+/*!
+    @brief Collect the changes since the previous delta
+    @param ctx Game context
+    @return Delta owned by the context
+*/
+const FrameDelta *TetrisUpdateFrameDelta(TetrisContext *ctx) {
+  if (ctx->dirty) MaterializeField(ctx);
+
+  return DeltaCollect(&ctx->tracker, &ctx->gameInfo);
+}
 
 /*!
     @brief Get last pressed key
+    @param ctx Game context
     @return Last pressed key
 */
-int getTetrisLastKey() { return game.last_key; }
+int TetrisGetLastKey(const TetrisContext *ctx) { return ctx->game.last_key; }
 
 /*!
     @brief Get current state
+    @param ctx Game context
     @return Current state
 */
-State getTetrisState() { return game.state; }
+State TetrisGetState(const TetrisContext *ctx) { return ctx->game.state; }
+
+/*!
+    @brief Get rows removed by the last attached figure
+    @param ctx Game context
+    @return Bit i is set if row i of the field was removed
+*/
+uint32_t TetrisGetClearedRows(const TetrisContext *ctx) {
+  return ctx->cleared;
+}
+
+/*!
+    @brief Take the board rows changed since the previous call
+    @param ctx Game context
+    @return Bit i is set if row i of the board changed
+
+    Lets headless users keep their own copy of the board without
+    building the field
+*/
+uint32_t TetrisTakeChangedRows(TetrisContext *ctx) {
+  uint32_t changed = ctx->changed;
+
+  ctx->changed = 0;
+
+  return changed;
+}
 
 /*!
     @brief Initialize game information
+    @param ctx Game context
 */
-void TetrisGameInfoInit() {
-  CreateMatrix(FieldRows, FieldCols, &gameInfo.field);
+void GameInfoInit(TetrisContext *ctx) {
+  CreateMatrix(FieldRows, FieldCols, &ctx->gameInfo.field);
 
   for (int i = 0; i < FieldRows; i++)
     for (int j = 0; j < FieldCols; j++)
       if ((j == 0 || j == 11) || i == FieldRows - 1)
-        gameInfo.field[i][j] = '\0';
+        ctx->gameInfo.field[i][j] = '\0';
       else
-        gameInfo.field[i][j] = ' ';
+        ctx->gameInfo.field[i][j] = ' ';
+
+  ctx->gameInfo.field[0][0] = FieldRows;  // height
+  ctx->gameInfo.field[1][0] = FieldCols;
 
-  gameInfo.field[0][0] = FieldRows;  // height
-  gameInfo.field[1][0] = FieldCols;
+  BoardInit(&ctx->board);
 
-  CreateMatrix(4, 6, &gameInfo.next);
+  ctx->figure.active = 0;
+  ctx->cleared = 0;
+  ctx->dirty = 0;
+  ctx->touched = 0;
+  ctx->changed = (1u << (FieldRows - 1)) - 1;
+  ctx->drawn = 0;
+  ctx->lines = 0;
+  ctx->started = LeaderboardNow();
+  ctx->records = "records/leaderboard";
+  ctx->persistent = 1;
 
-  gameInfo.score = 0;
+  DeltaTrackerInit(&ctx->tracker, FieldRows, FieldCols);
 
-  gameInfo.high_score = GetHighScore("records/records");
+  CreateMatrix(4, 6, &ctx->gameInfo.next);
 
-  gameInfo.level = 1;
+  ctx->gameInfo.score = 0;
+  ctx->gameInfo.high_score = 0;
 
-  gameInfo.speed = defineTetrisTime(gameInfo.level);
+  ctx->gameInfo.level = 1;
 
-  gameInfo.pause = 0;
+  ctx->gameInfo.speed = defineTetrisTime(ctx->gameInfo.level);
 
-  SetNextFigure(rand() % 7);
+  ctx->gameInfo.pause = 0;
 
-  gameInfo.next[0][5] = rand() % 7;  // next color
+  ctx->bagged = 0;
+
+  TetrisSetSeed(ctx, RandomEntropy());
 }
 
 /*!
-    @brief Delete game structure
+    @brief Empty the board leaving only the borders
+    @param board Board
 */
-void DeleteGameInfo() {
-  if (gameInfo.field) RemoveMatrix(gameInfo.field, FieldRows);
+void BoardInit(TetrisBoard *board) {
+  for (int i = 0; i < FieldRows; i++) {
+    board->rows[i] = RowWallMask;
+    board->slots[i] = i;
+  }
+
+  board->rows[FieldRows - 1] = RowFloorMask;
 
-  if (gameInfo.next) RemoveMatrix(gameInfo.next, 4);
+  memset(board->colors, 0, sizeof(board->colors));
 }
 
 /*!
-    @brief Assigning symbol matrix elements to spaces
-    @param field Field
-    @param row1 First row
-    @param row2 Last row
-    @param col1 First column
-    @param col2 Last column
+    @brief Build the field matrix from the board and the falling figure
+    @param ctx Game context
 */
-void ClearField(int **field, int row1, int row2, int col1, int col2) {
-  for (int i = row1; i <= row2; i++) {
-    for (int j = col1; j <= col2; j++) {
-      field[i][j] = ' ';
-    }
+void MaterializeField(TetrisContext *ctx) {
+  const TetrisBoard *board = &ctx->board;
+  int **field = ctx->gameInfo.field;
+
+  uint32_t covered = ctx->figure.active ? FigureRows(&ctx->figure) : 0;
+  uint32_t rows = (ctx->touched | ctx->drawn | covered) &
+                  ((1u << (FieldRows - 1)) - 1);
+
+  for (uint32_t left = rows; left; left &= left - 1) {
+    int i = __builtin_ctz(left);
+    const uint8_t *colors = board->colors[board->slots[i]];
+
+    for (int j = LeftBorder; j < RightBorder; j++)
+      field[i][j] = (board->rows[i] >> j & 1) ? FigureSym + colors[j] : ' ';
   }
+
+  if (ctx->figure.active) {
+    const TetrisFigure *figure = &ctx->figure;
+    const FigureCell *cells =
+        figureRotations[figure->type][figure->rotation].cells;
+
+    for (int i = 0; i < 4; i++)
+      field[figure->row + cells[i].row][figure->col + cells[i].col] =
+          FigureSym + figure->color;
+  }
+
+  DeltaTouchRows(&ctx->tracker, rows);
+
+  ctx->touched = 0;
+  ctx->drawn = covered;
+  ctx->dirty = 0;
 }
 
 /*!
-    @brief Removing the current figure from the field
-    @param axis Axis
-    @param term Term
-
-    Removing the current figure from the field and shifting it to a term.
-    Also color field clearing
+    @brief Rows covered by the figure
+    @param figure Figure
+    @return Bit i is set if the figure has a block in row i
 */
-void ResettingOldFigure(int axis, int term) {
-  for (int i = 0, x = 0, y = 0; i < 4; i++) {
-    x = gameInfo.next[0][i];  // x
-    y = gameInfo.next[1][i];  // y
+uint32_t FigureRows(const TetrisFigure *figure) {
+  const FigureRotation *rotation =
+      &figureRotations[figure->type][figure->rotation];
 
-    gameInfo.field[x][y] = ' ';
-
-    gameInfo.next[axis][i] += term;
-  }
+  return ((1u << rotation->height) - 1) << (figure->row + rotation->top);
 }
 
 /*!
-    @brief Checking for cell accessibility after shift
-    @return Count of free cells
+    @brief Checking the figure against the board
+    @param board Board
+    @param figure Figure
+    @return 1 if the figure overlaps blocks or borders
 */
-int CheckingFreePosition() {
-  int count = 0;
+int FigureCollides(const TetrisBoard *board, const TetrisFigure *figure) {
+  const FigureRotation *rotation =
+      &figureRotations[figure->type][figure->rotation];
 
-  for (int i = 0, x = 0, y = 0; i < 4; i++) {
-    x = gameInfo.next[0][i];  // x
-    y = gameInfo.next[1][i];  // y
+  int top = figure->row + rotation->top;
+  int left = figure->col + rotation->left;
 
-    if (gameInfo.field[x][y] >= ' ' && gameInfo.field[x][y] < FigureSym)
-      count++;
-  }
+  if (top < 0 || top + rotation->height > FieldRows || left < 0 || left > 15)
+    return 1;
 
-  return count;
+  for (int i = 0; i < rotation->height; i++)
+    if (board->rows[top + i] & rotation->masks[i] << left) return 1;
+
+  return 0;
 }
 
 /*!
-    @brief Returning the figure back
-    @param axis Axis
-    @param term Term
-
-    If the field spaces are already occupied, then return the figure back
+    @brief Shifting the falling figure if there is room
+    @param ctx Game context
+    @param rows Rows term
+    @param cols Columns term
+    @return 1 if the figure was shifted
 */
-void ReturnFigureBack(int axis, int term) {
-  for (int i = 0; i < 4; i++) gameInfo.next[axis][i] -= term;
+int ShiftFigure(TetrisContext *ctx, int rows, int cols) {
+  TetrisFigure moved = ctx->figure;
+
+  moved.row += rows;
+  moved.col += cols;
+
+  if (FigureCollides(&ctx->board, &moved)) return 0;
+
+  ctx->figure = moved;
+  ctx->dirty = 1;
+
+  return 1;
 }
 
 /*!
-    @brief Shifting a piece down the field onto a cell
+    @brief Attach the falling figure to the board
+    @param ctx Game context
 */
-void FigureDown() {
-  if (game.state != Shifting) return;
+void LockFigure(TetrisContext *ctx) {
+  TetrisFigure *figure = &ctx->figure;
 
-  bool figure_is_stopped = false;
+  if (!figure->active) return;
 
-  ResettingOldFigure(0, 1);
+  const FigureCell *cells =
+      figureRotations[figure->type][figure->rotation].cells;
 
-  int number_of_free_positions = CheckingFreePosition();
+  for (int i = 0; i < 4; i++) {
+    int row = figure->row + cells[i].row;
+    int col = figure->col + cells[i].col;
 
-  if (number_of_free_positions != 4) {
-    ReturnFigureBack(0, 1);
-    figure_is_stopped = true;
+    ctx->board.rows[row] |= (uint16_t)(1u << col);
+    ctx->board.colors[ctx->board.slots[row]][col] = figure->color;
   }
 
-  if (figure_is_stopped) game.state = Attaching;
+  ctx->touched |= FigureRows(figure);
+  ctx->changed |= FigureRows(figure);
 
-  TransferFigureToField();
+  figure->active = 0;
+  ctx->dirty = 1;
 }
 
 /*!
-    @brief Takes a new figure from figures.c
-
-    Also color field filling and setting the next figure and her color
+    @brief Shifting a piece down the field onto a cell
+    @param ctx Game context
 */
-void DropFigure() {
-  int number = GetNextFigure();
-
-  gameInfo.next[1][5] = gameInfo.next[0][5];
+void FigureDown(TetrisContext *ctx) {
+  if (ctx->game.state != Shifting) return;
 
-  SetCurrentFigure(number);
-
-  // for (int i = 0, k = 0; (i < 2); i++)
-  //   for (int j = 3, f_j = 0; (j < 8); j++, f_j++) {
-
-  //     if (getFigureIndex(number * 2 + i,f_j)) {
-  //       gameInfo.next[0][k] = i; // x
-
-  //  	    gameInfo.next[1][k] = j; // y
+  if (!ShiftFigure(ctx, 1, 0)) ctx->game.state = Attaching;
+}
 
-  //       k++;
-  //     }
-  //   }
+/*!
+    @brief Takes a new figure from figures.c
+    @param ctx Game context
 
-  for (int i = 0, k = 0; (i < 2); i++)
-    for (int j = 3, f_j = 0; (j < 7); j++, f_j++) {
-      if (gameInfo.next[i + 2][f_j]) {
-        gameInfo.next[0][k] = i;
+    Also setting the next figure and her color
+*/
+void DropFigure(TetrisContext *ctx) {
+  TetrisFigure *figure = &ctx->figure;
 
-        gameInfo.next[1][k] = j + 1;
+  int number = GetNextFigure(ctx);
 
-        k++;
-      }
-    }
+  figure->color = ctx->gameInfo.next[0][5];
 
-  number = (rand() % 7);
+  SetCurrentFigure(ctx, number);
 
-  SetNextFigure(number);
+  figure->rotation = 0;
+  figure->row = figurePivots[number].row;
+  figure->col = figurePivots[number].col + SpawnColumn;
+  figure->active = 1;
+  ctx->dirty = 1;
 
-  gameInfo.next[0][5] = rand() % 7;
+  SetNextFigure(ctx, RandomFigure(ctx));
 
-  TransferFigureToField();
+  ctx->gameInfo.next[0][5] = RandomBelow(&ctx->rng, 7);
 }
 
 /*!
     @brief Set next figure
+    @param ctx Game context
     @param next Next figure
 */
-void SetNextFigure(int next) {
-  gameInfo.next[0][4] = next;
+void SetNextFigure(TetrisContext *ctx, int next) {
+  const FigureCell *cells = figureRotations[next][0].cells;
+  const FigureCell pivot = figurePivots[next];
 
-  for (int i = 0, i_ = 2; i < 2; ++i, ++i_)
-    for (int j = 1; j < 5; ++j) {
-      if (getFigureIndex(next * 2 + i, j))
-        gameInfo.next[i_][j - 1] = 1;
-      else
-        gameInfo.next[i_][j - 1] = 0;
-    }
+  ctx->gameInfo.next[0][4] = next;
+
+  for (int i = 2; i < 4; ++i)
+    for (int j = 0; j < 4; ++j) ctx->gameInfo.next[i][j] = 0;
+
+  for (int i = 0; i < 4; ++i) {
+    int row = 2 + pivot.row + cells[i].row;
+
+    ctx->gameInfo.next[row][pivot.col + cells[i].col] = 1;
+  }
 }
 
 /*!
     @brief Get next figure
+    @param ctx Game context
     @return Next figure
 */
-int GetNextFigure() { return gameInfo.next[0][4]; }
+int GetNextFigure(const TetrisContext *ctx) {
+  return ctx->gameInfo.next[0][4];
+}
+
+/*!
+    @brief Draw the number of a new figure
+    @param ctx Game context
+    @return Figure number
+*/
+int RandomFigure(TetrisContext *ctx) {
+  return ctx->bagged ? RandomBagNext(&ctx->bag, &ctx->rng)
+                     : RandomBelow(&ctx->rng, 7);
+}
 
 /*!
     @brief Set current figure
+    @param ctx Game context
     @param current Current figure
 */
-void SetCurrentFigure(int current) { gameInfo.next[1][4] = current; }
+void SetCurrentFigure(TetrisContext *ctx, int current) {
+  ctx->figure.type = current;
+}
 
 /*!
     @brief Get current figure
+    @param ctx Game context
     @return Current figure
 */
-int GetCurrentFigure() { return gameInfo.next[1][4]; }
-
-/*!
-    @brief Transfer figure to field and color to color field
-*/
-void TransferFigureToField() {
-  for (int i = 0, x = 0, y = 0; i < 4; i++) {
-    x = gameInfo.next[0][i];
-    y = gameInfo.next[1][i];
-
-    gameInfo.field[x][y] = FigureSym + gameInfo.next[1][5];
-  }
-}
+int GetCurrentFigure(const TetrisContext *ctx) { return ctx->figure.type; }
 
 /*!
     @brief Move horizontal
+    @param ctx Game context
     @param side Left or right
 */
-void MoveHorizontal(char *side) {
+void MoveHorizontal(TetrisContext *ctx, char *side) {
   int step = (!strcmp(side, "left")) ? -1 : 1;
 
-  ResettingOldFigure(1, step);
-
-  int number_of_free_positions = CheckingFreePosition();
-
-  if (number_of_free_positions != 4) ReturnFigureBack(1, step);
-
-  TransferFigureToField();
+  ShiftFigure(ctx, 0, step);
 }
 
 /*!
-    @brief Rotating a figure via the rotation matrix
-*/
-void Rotate() {
-  if (GetCurrentFigure() == 4) return;
-
-  int px = gameInfo.next[0][2];
-  int py = gameInfo.next[1][2];
-
-  ResettingOldFigure(0, 0);
+    @brief Rotating a figure to its next rotation state
+    @param ctx Game context
 
-  int collision = 0;
+    Wall kick tests of the figure are tried in order until one fits
+*/
+void Rotate(TetrisContext *ctx) {
+  const FigureKicks *kicks = &figureKicks[GetCurrentFigure(ctx)];
 
-  for (int i = 0; i < 4; i++) {
-    int x1 = gameInfo.next[0][i];
-    int y1 = gameInfo.next[1][i];
+  TetrisFigure rotated = ctx->figure;
 
-    int x2 = px + py - y1;
-    int y2 = x1 + py - px;
+  rotated.rotation = (rotated.rotation + 1) % RotationsCount;
 
-    if (x2 < 0 || x2 >= FieldRows || y2 < 0 || y2 >= RightBorder ||
-        !(gameInfo.field[x2][y2] >= ' ' && gameInfo.field[x2][y2] < FigureSym))
-      collision = 1;
-  }
+  for (int i = 0; i < kicks->count; i++) {
+    TetrisFigure kicked = rotated;
 
-  if (!collision)
-    for (int i = 0; i < 4; i++) {
-      int x1 = gameInfo.next[0][i];
-      int y1 = gameInfo.next[1][i];
+    kicked.row += kicks->tests[i].row;
+    kicked.col += kicks->tests[i].col;
 
-      gameInfo.next[0][i] = px + py - y1;
-      gameInfo.next[1][i] = py - (px - x1);
+    if (!FigureCollides(&ctx->board, &kicked)) {
+      ctx->figure = kicked;
+      ctx->dirty = 1;
+      return;
     }
-
-  TransferFigureToField();
+  }
 }
 
 /*!
     @brief Checking the end of the game after attaching
+    @param ctx Game context
 */
-void GameOverCheck() {
-  for (int i = 0; i < 2; i++)
-    for (int j = LeftBorder; j < RightBorder; j++) {
-      if (gameInfo.field[i][j] >= FigureSym) {
-        game.state = GameOver;
-        return;
-      }
-    }
+void GameOverCheck(TetrisContext *ctx) {
+  if ((ctx->board.rows[0] | ctx->board.rows[1]) & RowFullMask)
+    ctx->game.state = GameOver;
 }
 
 /*!
     @brief Removing filled lines
+    @param ctx Game context
+    @return Bit i is set if row i of the field was removed
 
     Replenishment of points after the destruction of lines
-    and shifting the field down a cell
+    and shifting the field down in a single pass
 */
-void RemovingFilledLines() {
-  int removed_lines = 0, count = 0;
+uint32_t RemovingFilledLines(TetrisContext *ctx) {
+  TetrisBoard *board = &ctx->board;
 
-  for (int i = FieldRows - 2; i > 1; i--) {
-    for (int j = LeftBorder; j < RightBorder; j++)
-      if (gameInfo.field[i][j] >= FigureSym) count++;
+  uint32_t cleared = 0;
+  uint8_t freed[FieldRows];
+  int removed_lines = 0;
+  int to = FieldRows - 2;
 
-    if (count == 10) {
-      FieldDown(i);
-      removed_lines++;
-      i++;
+  for (int i = FieldRows - 2; i >= 0; i--) {
+    if (i > 1 && (board->rows[i] & RowFullMask) == RowFullMask) {
+      cleared |= 1u << i;
+      freed[removed_lines++] = board->slots[i];
+      continue;
     }
 
-    count = 0;
+    board->rows[to] = board->rows[i];
+    board->slots[to] = board->slots[i];
+    to--;
+  }
+
+  for (int k = 0; to >= 0; to--, k++) {
+    board->rows[to] = RowWallMask;
+    board->slots[to] = freed[k];
   }
 
-  ProcessingRemovedLines(removed_lines);
+  if (cleared) {
+    ctx->touched |= (2u << (31 - __builtin_clz(cleared))) - 1;
+    ctx->changed |= (2u << (31 - __builtin_clz(cleared))) - 1;
+    ctx->dirty = 1;
+  }
+
+  ProcessingRemovedLines(ctx, removed_lines);
+
+  return cleared;
 }
 
 /*!
     @brief Increase in points from destroying lines
+    @param ctx Game context
 
     Also updating the record and increasing the level with speed
 */
-void ProcessingRemovedLines(int removed_lines) {
+void ProcessingRemovedLines(TetrisContext *ctx, int removed_lines) {
   int score = 0;
 
   switch (removed_lines) {
@@ -383,203 +534,240 @@ void ProcessingRemovedLines(int removed_lines) {
       break;
   }
 
-  gameInfo.score += score;
+  ctx->gameInfo.score += score;
+  ctx->lines += removed_lines;
 
-  if (gameInfo.score > gameInfo.high_score)
-    gameInfo.high_score = gameInfo.score;
+  if (ctx->gameInfo.score > ctx->gameInfo.high_score)
+    ctx->gameInfo.high_score = ctx->gameInfo.score;
 
-  int level_increase = gameInfo.score / 600 + 1;
+  int level_increase = ctx->gameInfo.score / 600 + 1;
 
   if (level_increase > 10) level_increase = 1;
 
-  gameInfo.level = level_increase;
-  gameInfo.speed = defineTetrisTime(gameInfo.level);
-}
-
-/*!
-    @brief Shifting the field down a cell
-*/
-void FieldDown(int row) {
-  for (int i = row; i >= 1; i--)
-    for (int j = LeftBorder, c_j = 0; j < RightBorder; j++, c_j++)
-      gameInfo.field[i][j] = gameInfo.field[i - 1][j];
-
-  for (int j = LeftBorder; j < RightBorder; j++) gameInfo.field[0][j] = ' ';
+  ctx->gameInfo.level = level_increase;
+  ctx->gameInfo.speed = defineTetrisTime(ctx->gameInfo.level);
 }
 
 /*!
     @brief Saving the high score to the file
+    @param ctx Game context
     @param path Path to the file
-*/
-void SaveHighScore(const char *path) {
-  mkdir("records", 0777);
-
-  FILE *filePointer = fopen(path, "w");
-
-  if (filePointer == NULL) return;
+    @see PersistHighScore
 
-  fprintf(filePointer, "HighScore = %d", gameInfo.high_score);
+    The file is written by the persistence worker, games that are not
+    persistent are not saved
+*/
+void SaveHighScore(const TetrisContext *ctx, const char *path) {
+  if (!ctx->persistent) return;
 
-  fclose(filePointer);
+  PersistHighScore(path, ctx->gameInfo.high_score);
 }
 
 /*!
     @brief Getting the high score from the file
     @param path Path to the file
+    @see ScoreStoreMigrate
+
+    A missing file takes the score of the file shared by the games
+    in earlier versions
 */
 int GetHighScore(const char *path) {
-  FILE *filePointer = fopen(path, "r");
-
-  if (filePointer == NULL) return 0;
-
-  char line[256] = {0};
+  return ScoreStoreMigrate(path, ScoreStoreLegacyPath);
+}
 
-  int high_score = 0;
+/*!
+    @brief Taking the high score of the player from the file
+    @param ctx Game context
 
-  while (fgets(line, 256, filePointer) != NULL) {
-    if (strstr(line, "HighScore = ") != NULL) {
-      int n = 0;
-      n = sscanf(line, "HighScore = %d", &high_score);
+    Only live games call it, simulated and replayed games start from
+    zero and never read the records
+*/
+void TetrisLoadHighScore(TetrisContext *ctx) {
+  TraceBegin("GetHighScore");
+  ctx->gameInfo.high_score = GetHighScore("records/tetris");
+  TraceEnd("GetHighScore");
+}
 
-      if (n < 1) high_score = 0;
+/*!
+    @brief Recording the finished game in the leaderboard
+    @param ctx Game context
+    @param path Path to the leaderboard file, NULL to skip
 
-      break;
-    }
-  }
+    Games without points and games that are not persistent are not
+    recorded, the entry is written by the persistence worker
+*/
+void RecordGame(const TetrisContext *ctx, const char *path) {
+  if (!ctx->persistent || path == NULL || ctx->gameInfo.score <= 0) return;
 
-  fclose(filePointer);
+  LeaderboardEntry entry;
 
-  return high_score;
+  LeaderboardEntryInit(&entry, ctx->gameInfo.score, ctx->gameInfo.level,
+                       ctx->lines, LeaderboardNow() - ctx->started);
+  PersistRecord(path, LeaderboardTetris, &entry);
 }
 
 /*!
     @brief Restarting the game after game over
+    @param ctx Game context
 */
-void Restart() {
-  ClearField(gameInfo.field, 0, FieldRows - 2, LeftBorder, RightBorder - 1);
+void Restart(TetrisContext *ctx) {
+  BoardInit(&ctx->board);
 
-  gameInfo.score = 0;
-  gameInfo.level = 1;
-  gameInfo.speed = defineTetrisTime(gameInfo.level);
-  gameInfo.pause = 0;
+  ctx->figure.active = 0;
+  ctx->cleared = 0;
+  ctx->dirty = 1;
+  ctx->touched = (1u << (FieldRows - 1)) - 1;
+  ctx->changed = ctx->touched;
+
+  ctx->gameInfo.score = 0;
+  ctx->gameInfo.level = 1;
+  ctx->gameInfo.speed = defineTetrisTime(ctx->gameInfo.level);
+  ctx->gameInfo.pause = 0;
 }
 
 /*!
     @brief Attaching stage
+    @param ctx Game context
 */
-void AttachingStage() {
-  GameOverCheck();
+void AttachingStage(TetrisContext *ctx) {
+  LockFigure(ctx);
+
+  GameOverCheck(ctx);
+
+  if (ctx->game.state == GameOver) {
+    TraceBegin("RecordGame");
+    RecordGame(ctx, ctx->records);
+    TraceEnd("RecordGame");
 
-  if (game.state == GameOver) {
-    Restart();
+    Restart(ctx);
     return;
   }
 
-  RemovingFilledLines();
+  TraceBegin("RemovingFilledLines");
+  ctx->cleared = RemovingFilledLines(ctx);
+  TraceEnd("RemovingFilledLines");
 
-  game.state = Spawn;
+  ctx->game.state = Spawn;
 }
 
 /*!
     @brief Processing status after user input
+    @param ctx Game context
     @param action User action
 */
-int StatusProcessing(UserAction_t action) {
-  if (game.key == ENTER && (game.state == Launch || game.state == GameOver)) {
-    game.state = Spawn;
-    game.blocking = 1;
+int StatusProcessing(TetrisContext *ctx, UserAction_t action) {
+  if (ctx->game.key == ENTER &&
+      (ctx->game.state == Launch || ctx->game.state == GameOver)) {
+    ctx->game.state = Spawn;
+    ctx->game.blocking = 1;
+    ctx->lines = 0;
+    ctx->started = LeaderboardNow();
   }
 
-  if (action == Start && game.key != -1) game.blocking = 1;
+  if (action == Start && ctx->game.key != -1) ctx->game.blocking = 1;
 
-  if (gameInfo.pause && game.key != PAUSE && game.key != QUIT) return 1;
-
-  game.clicks = (game.clicks == 5) ? 1 : game.clicks + 1;
+  if (ctx->gameInfo.pause && ctx->game.key != PAUSE && ctx->game.key != QUIT)
+    return 1;
 
   return 0;
 }
 
 /*!
     @brief Control of the game logic
+    @param ctx Game context
     @param action User action
     @param hold Flag of hold
 */
-void userInput(UserAction_t action, bool hold) {
+void TetrisUserInput(TetrisContext *ctx, UserAction_t action, bool hold) {
   // game.key = new_key;
-  game.last_key = game.key;
+  ctx->game.last_key = ctx->game.key;
 
-  if (StatusProcessing(action)) return;
+  if (StatusProcessing(ctx, action)) return;
 
-  if (game.state == Moving || action == Terminate) {
-    actionProcessing(action, hold);
+  if (ctx->game.state == Moving || action == Terminate) {
+    TraceBegin("actionProcessing");
+    actionProcessing(ctx, action, hold);
+    TraceEnd("actionProcessing");
 
     if (action == Up || action == Terminate) return;
 
-    if (action != Pause) ShiftingProcessing();
+    if (action != Pause) ShiftingProcessing(ctx);
   }
 
-  if (game.state == Spawn) {
-    DropFigure();
-    game.state = Moving;
+  if (ctx->game.state == Spawn) {
+    DropFigure(ctx);
+    ctx->game.state = Moving;
   }
 }
 
 /*!
     @brief Process user input
+    @param ctx Game context
     @param action User action
     @param hold Hold action
 */
-void actionProcessing(UserAction_t action, bool hold) {
+void actionProcessing(TetrisContext *ctx, UserAction_t action, bool hold) {
   switch (action) {
     case Up:
       break;
     case Action:  // Rotate
-      Rotate();
-      game.move = 1;
+      Rotate(ctx);
       break;
     case Right:
-      MoveHorizontal("right");
-      game.move = 1;
+      MoveHorizontal(ctx, "right");
       break;
     case Left:
-      MoveHorizontal("left");
-      game.move = 1;
+      MoveHorizontal(ctx, "left");
       break;
     case Down:
-      if (hold) gameInfo.speed = defineTetrisTime(gameInfo.level + 1);
+      ctx->game.drop = 1;
+
+      if (hold)
+        ctx->gameInfo.speed = defineTetrisTime(ctx->gameInfo.level + 1);
       break;
     case Pause:
       // gameInfo.pause = (gameInfo.pause) ? 0 : 1;
-      gameInfo.pause = !gameInfo.pause;
+      ctx->gameInfo.pause = !ctx->gameInfo.pause;
       break;
     case Terminate:
-      SaveHighScore("records/records");
+      TraceBegin("SaveHighScore");
+      SaveHighScore(ctx, "records/tetris");
+      TraceEnd("SaveHighScore");
+
+      TraceBegin("RecordGame");
+      RecordGame(ctx, ctx->records);
+      TraceEnd("RecordGame");
       return;
     default:
       break;
   }
 
   if (action == Down && !hold)
-    gameInfo.speed = defineTetrisTime(gameInfo.level);
+    ctx->gameInfo.speed = defineTetrisTime(ctx->gameInfo.level);
 }
 
 /*!
     @brief Processing shifting and state after moving
+    @param ctx Game context
+
+    Gravity only acts on ticks, which come without a key, and on
+    a soft drop, so the falling speed does not depend on how fast
+    other keys are pressed
 */
-void ShiftingProcessing() {
-  int click = game.clicks % 5;
+void ShiftingProcessing(TetrisContext *ctx) {
+  int tick = ctx->game.key == -1;
 
-  game.state = Shifting;
+  ctx->game.state = Shifting;
 
-  if ((!game.move || click == 0) && !game.blocking) FigureDown();
+  if ((tick || ctx->game.drop) && !ctx->game.blocking) FigureDown(ctx);
 
-  game.blocking = 0;
-  game.move = 0;
+  ctx->game.blocking = 0;
+  ctx->game.drop = 0;
 
-  if (game.state == Attaching)
-    AttachingStage();
+  if (ctx->game.state == Attaching)
+    AttachingStage(ctx);
   else
-    game.state = Moving;
+    ctx->game.state = Moving;
 }
 
 /*!
@@ -588,8 +776,110 @@ void ShiftingProcessing() {
 */
 int defineTetrisTime(int level) { return 600 - level * 25; }
 
+/*!
+    @brief Set new pressed key
+    @param ctx Game context
+    @param new_key New pressed key
+*/
+void TetrisSetKey(TetrisContext *ctx, int new_key) { ctx->game.key = new_key; }
+
+/*!
+    @brief Seed the generator of the figures
+    @param ctx Game context
+    @param seed Seed
+
+    The next figure is drawn again, so the same seed and input give
+    the same game
+*/
+void TetrisSetSeed(TetrisContext *ctx, uint64_t seed) {
+  ctx->seed = seed;
+
+  RandomSeed(&ctx->rng, seed);
+  RandomBagInit(&ctx->bag);
+
+  SetNextFigure(ctx, RandomFigure(ctx));
+
+  ctx->gameInfo.next[0][5] = RandomBelow(&ctx->rng, 7);  // next color
+}
+
+/*!
+    @brief Get the seed of the generator
+    @param ctx Game context
+    @return Seed
+*/
+uint64_t TetrisGetSeed(const TetrisContext *ctx) { return ctx->seed; }
+
+/*!
+    @brief Choose the randomizer of the figures
+    @param ctx Game context
+    @param bagged Non-zero for the 7-bag, zero for uniform draws
+
+    Takes effect after the next figure, set it before the seed to
+    reproduce a game
+*/
+void TetrisSetBag(TetrisContext *ctx, int bagged) {
+  ctx->bagged = bagged;
+
+  RandomBagInit(&ctx->bag);
+}
+
+/*!
+    @brief Tetris backend initialization
+*/
+void TetrisGameInit() { GameStateInit(&defaultContext); }
+
+/*!
+    @brief Initialize game information
+*/
+void TetrisGameInfoInit() {
+  GameInfoInit(&defaultContext);
+  TetrisLoadHighScore(&defaultContext);
+}
+
+/*!
+    @brief Delete game structure
+*/
+void DeleteGameInfo() { TetrisContextDestroy(&defaultContext); }
+
+/*!
+    @brief Update current state
+    @return Copied structure of game information
+*/
+GameInfo_t updateCurrentState() {
+  return TetrisUpdateCurrentState(&defaultContext);
+}
+
+/*!
+    @brief Collect the changes since the previous delta
+    @return Delta owned by the default context
+*/
+const FrameDelta *updateFrameDelta() {
+  return TetrisUpdateFrameDelta(&defaultContext);
+}
+
+/*!
+    @brief Get last pressed key
+    @return Last pressed key
+*/
+int getTetrisLastKey() { return TetrisGetLastKey(&defaultContext); }
+
+/*!
+    @brief Get current state
+    @return Current state
+*/
+State getTetrisState() { return TetrisGetState(&defaultContext); }
+
+/*!
+    @brief Control of the game logic
+    @param action User action
+    @param hold Flag of hold
+*/
+void userInput(UserAction_t action, bool hold) {
+  TetrisUserInput(&defaultContext, action, hold);
+}
+
 /*!
     @brief Set new pressed key
     @param new_key New pressed key
 */
-void setKey(int new_key) { game.key = new_key; }
\ No newline at end of file
+void setKey(int new_key) { TetrisSetKey(&defaultContext, new_key); }
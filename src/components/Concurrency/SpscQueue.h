@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Lock-free single producer single consumer queue
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace s21 {
+
+/**
+ * @brief Bounded lock-free queue for one producer and one consumer
+ * @tparam T Item type
+ * @tparam N Capacity, a power of two
+ */
+template <typename T, std::size_t N>
+class SpscQueue {
+  static_assert(N && !(N & (N - 1)), "capacity must be a power of two");
+
+  //! @brief Items
+  T items_[N];
+
+  //! @brief Number of pushed items
+  std::atomic<std::size_t> tail_;
+
+  //! @brief Number of popped items
+  std::atomic<std::size_t> head_;
+
+ public:
+  /**
+   * @brief Constructor
+   */
+  SpscQueue() : tail_(0), head_(0) {}
+
+  /**
+   * @brief Push item, called by the producer only
+   * @param item Item
+   * @return false if the queue is full
+   */
+  bool push(const T &item) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+    if (tail - head_.load(std::memory_order_acquire) == N) return false;
+
+    items_[tail & (N - 1)] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @brief Pop item, called by the consumer only
+   * @param item Popped item
+   * @return false if the queue is empty
+   */
+  bool pop(T &item) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+
+    item = items_[head & (N - 1)];
+    head_.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @brief Check if the queue is empty
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief Lock-free triple buffer
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+namespace s21 {
+
+/**
+ * @brief Lock-free triple buffer for one producer and one consumer
+ * @details The producer fills the back slot and publishes it by swapping
+ *          it with the middle one, the consumer takes the middle slot
+ *          the same way. Neither side ever waits and the consumer always
+ *          sees the newest complete value
+ * @tparam T Slot type
+ */
+template <typename T>
+class TripleBuffer {
+  //! @brief Flag of a middle slot that was not taken yet
+  static constexpr int Fresh = 4;
+
+  //! @brief Mask of a slot index
+  static constexpr int Index = 3;
+
+  //! @brief Slots
+  T slots_[3];
+
+  //! @brief Index of the middle slot with the fresh flag
+  std::atomic<int> middle_;
+
+  //! @brief Index of the producer slot
+  int back_;
+
+  //! @brief Index of the consumer slot
+  int front_;
+
+ public:
+  /**
+   * @brief Constructor
+   */
+  TripleBuffer() : middle_(2), back_(0), front_(1) {}
+
+  /**
+   * @brief Slot to be filled by the producer
+   */
+  T &back() { return slots_[back_]; }
+
+  /**
+   * @brief Publish the back slot
+   */
+  void publish() {
+    back_ = middle_.exchange(back_ | Fresh, std::memory_order_acq_rel) & Index;
+  }
+
+  /**
+   * @brief Take the newest published slot
+   * @return true if a new slot was taken
+   */
+  bool update() {
+    if (!(middle_.load(std::memory_order_relaxed) & Fresh)) return false;
+
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & Index;
+
+    return true;
+  }
+
+  /**
+   * @brief Slot taken by the consumer
+   */
+  const T &front() const { return slots_[front_]; }
+};
+}  // namespace s21
+
+#endif
@@ -5,7 +5,9 @@
 
 #include "Controller.h"
 
-int getInput(UserAction_t *action, bool *hold, int last_key, int new_key);
+#include "../Replay/Replay.h"
+
+int getInput(UserAction_t *action, int new_key);
 
 namespace s21 {
 
@@ -29,19 +31,45 @@ Controller::~Controller() { delete model; }
  * @details The view uses a structure for rendering
  */
 GameInfo_t Controller::updateCurrentState() {
-  return model->updateCurrentState();
+  GameInfo_t info = model->updateCurrentState();
+
+  if (recorder_) recorder_->check(info);
+
+  return info;
+}
+
+/**
+ * @brief Changes of the game since the previous call
+ * @return Changed cells and numbers
+ * @see FrameDelta
+ */
+const FrameDelta &Controller::updateFrameDelta() {
+  return model->updateFrameDelta();
 }
 
 /**!
  * @brief Get user input
  * @param action User action
- * @param hold Hold action
  * @param new_key New key
  * @see UserAction_t
  */
-void Controller::getInput(UserAction_t *action, bool *hold, int input_key) {
-  int key = ::getInput(action, hold, model->getLastKey(), input_key);
+void Controller::getInput(UserAction_t *action, int input_key) {
+  int key = ::getInput(action, input_key);
   model->setKey(key);
+  key_ = input_key;
+}
+
+/**
+ * @brief Map key to its action without passing it to the model
+ * @param key Key
+ * @see UserAction_t
+ */
+UserAction_t Controller::keyAction(int key) {
+  UserAction_t action = Start;
+
+  ::getInput(&action, key);
+
+  return action;
 }
 
 /**
@@ -53,9 +81,85 @@ void Controller::getInput(UserAction_t *action, bool *hold, int input_key) {
  * @details Is the entry point into the game logic
  */
 void Controller::userInput(UserAction_t action, bool hold) {
+  TraceScope trace("userInput");
+
+  if (recorder_) recorder_->record(key_, hold);
+
   model->userInput(action, hold);
 }
 
+/**
+ * @brief Record the keys fed to the model
+ * @param recorder Recorder, nullptr to stop recording
+ * @see ReplayRecorder
+ *
+ * @details Every userInput is recorded with the key of the getInput
+ *          before it, a checkpoint is taken on updateCurrentState
+ */
+void Controller::record(ReplayRecorder *recorder) { recorder_ = recorder; }
+
+/**
+ * @brief Let a replay drive the model instead of the keys
+ * @param player Player, nullptr for a live game
+ * @see ReplayPlayer
+ */
+void Controller::play(ReplayPlayer *player) { player_ = player; }
+
+/**
+ * @brief Player driving the model
+ * @return Player, nullptr for a live game
+ */
+ReplayPlayer *Controller::replay() const { return player_; }
+
+/**
+ * @brief Seed the random generator of the game
+ * @param seed Seed
+ */
+void Controller::setSeed(uint64_t seed) { model->setSeed(seed); }
+
+/**
+ * @brief Get the seed of the random generator
+ * @return Seed
+ */
+uint64_t Controller::getSeed() { return model->getSeed(); }
+
+/**
+ * @brief Choose the randomizer of the pieces
+ * @param bagged True for the 7-bag, false for uniform draws
+ */
+void Controller::setBag(bool bagged) { model->setBag(bagged); }
+
+/**
+ * @brief Copy the game
+ * @return Independent game in the same state
+ */
+std::unique_ptr<IModel> Controller::snapshot() { return model->snapshot(); }
+
+/**
+ * @brief Take the state of a snapshot
+ * @param snapshot Snapshot of a game of the same type
+ */
+void Controller::restore(const IModel &snapshot) { model->restore(snapshot); }
+
+/**
+ * @brief Set the leaderboard of finished games
+ * @param path Path to the leaderboard file, nullptr to skip
+ */
+void Controller::setRecords(const char *path) { model->setRecords(path); }
+
+/**
+ * @brief Keep the results of finished games
+ * @param persistent False skips the high score and the leaderboard
+ */
+void Controller::setPersistent(bool persistent) {
+  model->setPersistent(persistent);
+}
+
+/**
+ * @brief Take the high score of the player from the records
+ */
+void Controller::loadHighScore() { model->loadHighScore(); }
+
 /**
  * @brief Get state code
  * @return State code
@@ -8,6 +8,9 @@
 
 #ifdef __cplusplus
 
+#include <cstdint>
+#include <memory>
+
 #include "../Interfaces/IModel.h"
 
 extern "C" {
@@ -15,6 +18,7 @@ extern "C" {
 
 #include "../../brick_game/bg_enums.h"
 #include "../../components/GameInfo/GameInfo.h"
+#include "../trace/trace.h"
 
 #ifdef __cplusplus
 }
@@ -22,6 +26,9 @@ extern "C" {
 
 namespace s21 {
 
+class ReplayRecorder;
+class ReplayPlayer;
+
 /**
  * @brief Controller class
  * @details This class is used to separate the model from the view
@@ -30,6 +37,15 @@ class Controller {
   //! @brief Model pointer
   IModel* model;
 
+  //! @brief Recorder of the keys fed to the model, nullptr if none
+  ReplayRecorder* recorder_ = nullptr;
+
+  //! @brief Player driving the model, nullptr if none
+  ReplayPlayer* player_ = nullptr;
+
+  //! @brief Key of the last getInput, recorded by userInput
+  int key_ = -1;
+
  public:
   /**
    * @brief Constructor
@@ -51,11 +67,17 @@ class Controller {
   /**!
    * @brief Get user input
    * @param action User action
-   * @param hold Hold action
    * @param new_key New key
    * @see UserAction_t
    */
-  void getInput(UserAction_t* action, bool* hold, int new_key);
+  void getInput(UserAction_t* action, int new_key);
+
+  /**
+   * @brief Map key to its action without passing it to the model
+   * @param key Key
+   * @see UserAction_t
+   */
+  static UserAction_t keyAction(int key);
 
   /**
    * @brief Get state code
@@ -74,6 +96,83 @@ class Controller {
    */
   GameInfo_t updateCurrentState();
 
+  /**
+   * @brief Changes of the game since the previous call
+   * @return Changed cells and numbers
+   * @see FrameDelta
+   */
+  const FrameDelta& updateFrameDelta();
+
+  /**
+   * @brief Record the keys fed to the model
+   * @param recorder Recorder, nullptr to stop recording
+   * @see ReplayRecorder
+   *
+   * @details Every userInput is recorded with the key of the getInput
+   *          before it, a checkpoint is taken on updateCurrentState
+   */
+  void record(ReplayRecorder* recorder);
+
+  /**
+   * @brief Let a replay drive the model instead of the keys
+   * @param player Player, nullptr for a live game
+   * @see ReplayPlayer
+   */
+  void play(ReplayPlayer* player);
+
+  /**
+   * @brief Player driving the model
+   * @return Player, nullptr for a live game
+   */
+  ReplayPlayer* replay() const;
+
+  /**
+   * @brief Seed the random generator of the game
+   * @param seed Seed
+   */
+  void setSeed(uint64_t seed);
+
+  /**
+   * @brief Get the seed of the random generator
+   * @return Seed
+   */
+  uint64_t getSeed();
+
+  /**
+   * @brief Choose the randomizer of the pieces
+   * @param bagged True for the 7-bag, false for uniform draws
+   */
+  void setBag(bool bagged);
+
+  /**
+   * @brief Copy the game
+   * @return Independent game in the same state
+   */
+  std::unique_ptr<IModel> snapshot();
+
+  /**
+   * @brief Take the state of a snapshot
+   * @param snapshot Snapshot of a game of the same type
+   */
+  void restore(const IModel& snapshot);
+
+  /**
+   * @brief Set the leaderboard of finished games
+   * @param path Path to the leaderboard file, nullptr to skip
+   */
+  void setRecords(const char* path);
+
+  /**
+   * @brief Keep the results of finished games
+   * @param persistent False skips the high score and the leaderboard
+   */
+  void setPersistent(bool persistent);
+
+  /**
+   * @brief Take the high score of the player from the records
+   */
+  void loadHighScore();
+
   /**
    * @brief Destructor
    */
@@ -32,6 +32,8 @@ IView *GameFactory::createView(ViewType type, Controller &c) {
     return new ConsoleView(c);
   else if (type == ViewType::Qt)
     return new DesktopViewWrapper(c);
+  else if (type == ViewType::QtImage)
+    return new DesktopViewWrapper(c, RenderBackend::Image);
 
   return nullptr;
 }
@@ -72,6 +74,7 @@ ViewType getViewType() {
   std::cout << "     Choose view" << std::endl;
   std::cout << "       1. CLI" << std::endl;
   std::cout << "      2. Desktop" << std::endl;
+  std::cout << "   3. Desktop (image)" << std::endl;
 
   int type = 0;
 
@@ -81,6 +84,8 @@ ViewType getViewType() {
     return ViewType::CLI;
   else if (type == 2)
     return ViewType::Qt;
+  else if (type == 3)
+    return ViewType::QtImage;
   else
     std::exit(0);
 
@@ -26,8 +26,9 @@ enum class GameType : int {
  * @brief Enumeration of view types
  */
 enum class ViewType : int {
-  CLI,  ///< CLI view type
-  Qt    ///< Qt view type
+  CLI,     ///< CLI view type
+  Qt,      ///< Qt view type
+  QtImage  ///< Qt view type with the image field backend
 };
 
 /**
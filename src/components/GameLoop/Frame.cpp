@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @brief Implementation of game frame snapshot
+ */
+
+#include "Frame.h"
+
+#include <cstring>
+#include <new>
+
+namespace s21 {
+
+/**
+ * @brief Constructor
+ */
+Frame::Frame()
+    : info_(),
+      code_(0),
+      field_(nullptr),
+      rows_(0),
+      cols_(0),
+      next_(nullptr),
+      input_() {}
+
+/**
+ * @brief Destructor
+ */
+Frame::~Frame() {
+  if (field_) RemoveMatrix(field_, rows_);
+
+  if (next_) RemoveMatrix(next_, NextRows);
+}
+
+/**
+ * @brief Copy the game information
+ * @param info Game information
+ * @param code State code
+ * @param input Capture time of the oldest key shown first by the frame,
+ *              the epoch if there is none
+ * @see GameInfo_t
+ *
+ * @details Matrices are allocated by the first copy and reused later
+ */
+void Frame::assign(const GameInfo_t &info, int code,
+                   std::chrono::steady_clock::time_point input) {
+  info_ = info;
+  code_ = code;
+  input_ = input;
+
+  if (info.field) {
+    if (!field_) {
+      rows_ = info.field[0][0];
+      cols_ = info.field[1][0];
+
+      if (CreateMatrix(rows_, cols_, &field_)) throw std::bad_alloc();
+    }
+
+    for (int i = 0; i < rows_; i++)
+      std::memcpy(field_[i], info.field[i], cols_ * sizeof(int));
+  }
+
+  if (info.next) {
+    if (!next_ && CreateMatrix(NextRows, NextCols, &next_))
+      throw std::bad_alloc();
+
+    for (int i = 0; i < NextRows; i++)
+      std::memcpy(next_[i], info.next[i], NextCols * sizeof(int));
+  }
+
+  info_.field = info.field ? field_ : nullptr;
+  info_.next = info.next ? next_ : nullptr;
+}
+
+/**
+ * @brief Get game information
+ * @return Game information pointing into the frame
+ */
+const GameInfo_t &Frame::info() const { return info_; }
+
+/**
+ * @brief Get state code
+ */
+int Frame::code() const { return code_; }
+
+/**
+ * @brief Capture time of the oldest key shown first by the frame
+ * @return The epoch if there is none
+ */
+std::chrono::steady_clock::time_point Frame::input() const { return input_; }
+}  // namespace s21
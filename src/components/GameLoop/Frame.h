@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @brief Header of game frame snapshot
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#ifdef __cplusplus
+
+#include <chrono>
+
+extern "C" {
+#endif
+
+#include "../../brick_game/bg_enums.h"
+#include "../../components/GameInfo/GameInfo.h"
+#include "../cmatrix/cmatrix.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Immutable copy of the game information for the view
+ * @details Owns its field and next matrices, so the view can read it
+ *          while the model keeps changing its own
+ */
+class Frame {
+  //! @brief Game information pointing into the owned matrices
+  GameInfo_t info_;
+
+  //! @brief State code
+  int code_;
+
+  //! @brief Field copy
+  int **field_;
+
+  //! @brief Rows of the field copy
+  int rows_;
+
+  //! @brief Columns of the field copy
+  int cols_;
+
+  //! @brief Next field copy
+  int **next_;
+
+  //! @brief Capture time of the oldest key shown first by the frame
+  std::chrono::steady_clock::time_point input_;
+
+ public:
+  //! @brief Rows of the next field
+  static constexpr int NextRows = 4;
+
+  //! @brief Columns of the next field
+  static constexpr int NextCols = 6;
+
+  /**
+   * @brief Constructor
+   */
+  Frame();
+
+  /**
+   * @brief Destructor
+   */
+  ~Frame();
+
+  Frame(const Frame &) = delete;
+  Frame &operator=(const Frame &) = delete;
+
+  /**
+   * @brief Copy the game information
+   * @param info Game information
+   * @param code State code
+   * @param input Capture time of the oldest key shown first by the frame,
+   *              the epoch if there is none
+   * @see GameInfo_t
+   *
+   * @details Matrices are allocated by the first copy and reused later
+   */
+  void assign(const GameInfo_t &info, int code,
+              std::chrono::steady_clock::time_point input = {});
+
+  /**
+   * @brief Get game information
+   * @return Game information pointing into the frame
+   */
+  const GameInfo_t &info() const;
+
+  /**
+   * @brief Get state code
+   */
+  int code() const;
+
+  /**
+   * @brief Capture time of the oldest key shown first by the frame
+   * @return The epoch if there is none
+   */
+  std::chrono::steady_clock::time_point input() const;
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @brief Implementation of fixed timestep game loop
+ */
+
+#include "GameLoop.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructor
+ * @param controller Controller reference
+ * @param start Start of the schedule, the first tick is due one speed
+ *              interval later
+ * @see Controller
+ */
+GameLoop::GameLoop(Controller &controller, Clock::time_point start)
+    : controller_(controller),
+      info_(controller.updateCurrentState()),
+      dirty_(true) {
+  nextTick_ = start + std::chrono::milliseconds(info_.speed);
+  nextFrame_ = start;
+}
+
+/**
+ * @brief Pass the key to the model and collect the new state
+ * @param key Pressed key, -1 for a tick
+ * @param hold Key is held down
+ * @return Action of the key
+ *
+ * @details Values the model reports as unchanged (-1) do not overwrite
+ *          the ones still waiting to be rendered
+ */
+UserAction_t GameLoop::step(int key, bool hold) {
+  UserAction_t action = Start;
+
+  controller_.getInput(&action, key);
+  controller_.userInput(action, hold);
+
+  if (action == Terminate) return action;
+
+  GameInfo_t info = controller_.updateCurrentState();
+
+  if (info.high_score == -1) info.high_score = info_.high_score;
+  if (info.score == -1) info.score = info_.score;
+  if (info.level == -1) info.level = info_.level;
+
+  info_ = info;
+  dirty_ = true;
+
+  return action;
+}
+
+/**
+ * @brief Feed a pressed key to the model
+ * @param key Pressed key
+ * @param hold Key is held down
+ * @return false if the key terminates the game
+ */
+bool GameLoop::input(int key, bool hold) {
+  return step(key, hold) != Terminate;
+}
+
+/**
+ * @brief Run the ticks that are due
+ * @param now Current time
+ * @return Number of ticks run
+ *
+ * @details The schedule is dropped after MaxCatchUp late ticks,
+ *          so a stalled view does not fast forward the game
+ */
+int GameLoop::advance(Clock::time_point now) {
+  int ticks = 0;
+
+  while (nextTick_ <= now) {
+    if (ticks == MaxCatchUp) {
+      nextTick_ = now + std::chrono::milliseconds(info_.speed);
+      break;
+    }
+
+    step(-1, false);
+    ticks++;
+
+    nextTick_ += std::chrono::milliseconds(info_.speed);
+  }
+
+  return ticks;
+}
+
+/**
+ * @brief Check if a frame should be rendered
+ * @param now Current time
+ */
+bool GameLoop::frameDue(Clock::time_point now) const {
+  return dirty_ && nextFrame_ <= now;
+}
+
+/**
+ * @brief Take the frame to render
+ * @param now Current time
+ * @return Game information collected since the previous frame
+ * @see GameInfo_t
+ */
+GameInfo_t GameLoop::frame(Clock::time_point now) {
+  GameInfo_t info = info_;
+
+  info_.high_score = -1;
+  info_.score = -1;
+  info_.level = -1;
+
+  dirty_ = false;
+  nextFrame_ = now + std::chrono::milliseconds(FrameInterval);
+
+  return info;
+}
+
+/**
+ * @brief Time left until the next tick or frame
+ * @param now Current time
+ * @return Milliseconds to wait for input
+ */
+int GameLoop::delay(Clock::time_point now) const {
+  Clock::time_point deadline = nextTick_;
+
+  if (dirty_ && nextFrame_ < deadline) deadline = nextFrame_;
+
+  if (deadline <= now) return 0;
+
+  return std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+}
+}  // namespace s21
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @brief Header of fixed timestep game loop
+ */
+
+#ifndef GAMELOOP_H
+#define GAMELOOP_H
+
+#ifdef __cplusplus
+
+#include <chrono>
+
+#include "../Controller/Controller.h"
+
+extern "C" {
+#endif
+
+#include "../../brick_game/bg_enums.h"
+#include "../../components/GameInfo/GameInfo.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Fixed timestep game loop shared by the views
+ * @details The model is ticked every gameInfo.speed milliseconds on a fixed
+ *          schedule that keys never shift. Keys are fed to the model as they
+ *          arrive and the view renders at most once per frame interval
+ */
+class GameLoop {
+ public:
+  //! @brief Monotonic clock of the loop
+  using Clock = std::chrono::steady_clock;
+
+  //! @brief Shortest time between two rendered frames, in milliseconds
+  static constexpr int FrameInterval = 16;
+
+  //! @brief Most ticks run at once to catch up after a stall
+  static constexpr int MaxCatchUp = 5;
+
+  /**
+   * @brief Constructor
+   * @param controller Controller reference
+   * @param start Start of the schedule, the first tick is due one speed
+   *              interval later
+   * @see Controller
+   */
+  GameLoop(Controller &controller, Clock::time_point start = Clock::now());
+
+  /**
+   * @brief Feed a pressed key to the model
+   * @param key Pressed key
+   * @param hold Key is held down
+   * @return false if the key terminates the game
+   */
+  bool input(int key, bool hold);
+
+  /**
+   * @brief Run the ticks that are due
+   * @param now Current time
+   * @return Number of ticks run
+   */
+  int advance(Clock::time_point now);
+
+  /**
+   * @brief Check if a frame should be rendered
+   * @param now Current time
+   */
+  bool frameDue(Clock::time_point now) const;
+
+  /**
+   * @brief Take the frame to render
+   * @param now Current time
+   * @return Game information collected since the previous frame
+   * @see GameInfo_t
+   */
+  GameInfo_t frame(Clock::time_point now);
+
+  /**
+   * @brief Time left until the next tick or frame
+   * @param now Current time
+   * @return Milliseconds to wait for input
+   */
+  int delay(Clock::time_point now) const;
+
+ private:
+  /**
+   * @brief Pass the key to the model and collect the new state
+   * @param key Pressed key, -1 for a tick
+   * @param hold Key is held down
+   * @return Action of the key
+   */
+  UserAction_t step(int key, bool hold);
+
+  //! @brief Controller
+  Controller &controller_;
+
+  //! @brief Game information of the next frame
+  GameInfo_t info_;
+
+  //! @brief Something changed since the previous frame
+  bool dirty_;
+
+  //! @brief Time of the next tick
+  Clock::time_point nextTick_;
+
+  //! @brief Earliest time of the next frame
+  Clock::time_point nextFrame_;
+};
+}  // namespace s21
+
+#endif
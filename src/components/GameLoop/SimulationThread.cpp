@@ -0,0 +1,291 @@
+/**
+ * @file
+ * @brief Implementation of simulation thread
+ */
+
+#include "SimulationThread.h"
+
+namespace s21 {
+
+/**
+ * @brief Check if a key auto shifts when held
+ * @param key Key
+ */
+static bool isShift(int key) {
+  UserAction_t action = Controller::keyAction(key);
+
+  return action == Left || action == Right || action == Up || action == Down;
+}
+
+/**
+ * @brief Constructor
+ * @param controller Controller reference
+ * @param keymap Keymap of the view
+ * @param releases The view reports key releases
+ * @see Controller
+ */
+SimulationThread::SimulationThread(Controller &controller,
+                                   const Keymap &keymap, bool releases)
+    : controller_(controller),
+      keymap_(keymap),
+      loop_(controller),
+      shown_(controller.updateCurrentState()),
+      input_(isShift, releases),
+      followed_(),
+      shownKey_(0),
+      takenKey_(),
+      stop_(false),
+      running_(true) {}
+
+/**
+ * @brief Destructor
+ * @details Stops and joins the worker thread
+ */
+SimulationThread::~SimulationThread() { stop(); }
+
+/**
+ * @brief Start the worker thread
+ */
+void SimulationThread::start() {
+  worker_ = std::thread(&SimulationThread::run, this);
+}
+
+/**
+ * @brief Stop and join the worker thread
+ * @details After the call the latency and the model are no longer
+ *          written, so they can be read from the calling thread
+ */
+void SimulationThread::stop() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+
+  wake_.notify_one();
+
+  if (worker_.joinable()) worker_.join();
+}
+
+/**
+ * @brief Pass a key event to the worker thread
+ * @param key Key code of the view
+ * @param type Event type
+ * @details The key is translated by the keymap and the event is stamped
+ *          with the current time. It is dropped if the queue is full
+ */
+void SimulationThread::push(int key, InputEvent::Type type) {
+  InputEvent event = {keymap_.translate(key), type, GameLoop::Clock::now()};
+
+  if (!input_.push(event)) return;
+
+  std::lock_guard<std::mutex> lock(wakeMutex_);
+  wake_.notify_one();
+}
+
+/**
+ * @brief Take the newest published frame
+ * @return true if a new frame was taken
+ */
+bool SimulationThread::update() {
+  if (!frames_.update()) return false;
+
+  GameLoop::Clock::time_point key = frames_.front().input();
+
+  if (key.time_since_epoch().count() !=
+      shownKey_.load(std::memory_order_relaxed))
+    takenKey_ = key;
+
+  return true;
+}
+
+/**
+ * @brief Frame taken by the last update
+ * @see Frame
+ */
+const Frame &SimulationThread::frame() const { return frames_.front(); }
+
+/**
+ * @brief Check if the game was not terminated
+ */
+bool SimulationThread::running() const {
+  return running_.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Check if the taken frame shows a followed key first
+ * @details The view has to render it and call rendered()
+ */
+bool SimulationThread::awaitsRender() const {
+  return takenKey_ != GameLoop::Clock::time_point();
+}
+
+/**
+ * @brief Stamp the frame taken by the last update as on screen
+ * @details Called by the view once the frame is rendered
+ */
+void SimulationThread::rendered() {
+  if (!awaitsRender()) return;
+
+  latency_.photon.record(GameLoop::Clock::now() - takenKey_);
+  shownKey_.store(takenKey_.time_since_epoch().count(),
+                  std::memory_order_relaxed);
+
+  takenKey_ = GameLoop::Clock::time_point();
+}
+
+/**
+ * @brief Latency of the keys
+ * @see InputLatency
+ */
+const InputLatency &SimulationThread::latency() const { return latency_; }
+
+/**
+ * @brief Publish game information as a new frame
+ * @param info Game information
+ *
+ * @details The view may skip frames, so values the model reports as
+ *          unchanged (-1) are filled in from the previous frame. The
+ *          followed key is carried by every frame until one is rendered
+ */
+void SimulationThread::publish(GameInfo_t info) {
+  if (followed_.time_since_epoch().count() ==
+      shownKey_.load(std::memory_order_relaxed))
+    followed_ = GameLoop::Clock::time_point();
+
+  if (info.high_score == -1) info.high_score = shown_.high_score;
+  if (info.score == -1) info.score = shown_.score;
+  if (info.level == -1) info.level = shown_.level;
+
+  shown_ = info;
+
+  frames_.back().assign(info, controller_.getStateCode(), followed_);
+  frames_.publish();
+}
+
+/**
+ * @brief Time a key press taken by the model
+ * @param time Capture time of the key
+ */
+void SimulationThread::taken(GameLoop::Clock::time_point time) {
+  latency_.input.record(GameLoop::Clock::now() - time);
+
+  if (followed_ == GameLoop::Clock::time_point() ||
+      followed_.time_since_epoch().count() ==
+          shownKey_.load(std::memory_order_relaxed))
+    followed_ = time;
+}
+
+/**
+ * @brief Worker thread body
+ *
+ * @details All keys due are taken at once, each after the ticks that
+ *          were due before it was pressed
+ */
+void SimulationThread::run() {
+  if (ReplayPlayer *player = controller_.replay()) {
+    play(*player);
+    return;
+  }
+
+  while (!stop_.load(std::memory_order_acquire)) {
+    GameLoop::Clock::time_point now = GameLoop::Clock::now();
+    KeyInput key;
+
+    while (input_.poll(now, key)) {
+      loop_.advance(key.time);
+
+      if (!loop_.input(key.key, key.hold)) {
+        running_.store(false, std::memory_order_release);
+        return;
+      }
+
+      if (!key.hold) taken(key.time);
+    }
+
+    loop_.advance(now);
+
+    if (loop_.frameDue(now)) publish(loop_.frame(now));
+
+    now = GameLoop::Clock::now();
+
+    std::chrono::milliseconds delay(loop_.delay(now));
+
+    if (input_.deadline() < now + delay)
+      delay = std::chrono::ceil<std::chrono::milliseconds>(input_.deadline() -
+                                                           now);
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+
+    wake_.wait_for(lock, delay, [this] {
+      return stop_.load(std::memory_order_acquire) || !input_.empty();
+    });
+  }
+}
+
+/**
+ * @brief Worker thread body of a replay
+ * @param player Player driving the model
+ *
+ * @details The steps are played when the replay clock reaches their
+ *          time. Pause stops the clock, left and right move it by
+ *          SeekStep and the quit key ends the playback
+ */
+void SimulationThread::play(ReplayPlayer &player) {
+  GameLoop::Clock::time_point last = GameLoop::Clock::now();
+  uint32_t clock = player.time();
+  bool paused = false;
+
+  publish(player.info());
+
+  while (!stop_.load(std::memory_order_acquire)) {
+    GameLoop::Clock::time_point now = GameLoop::Clock::now();
+    bool moved = false;
+    KeyInput key;
+
+    if (!paused)
+      clock += std::chrono::duration_cast<std::chrono::milliseconds>(now -
+                                                                     last)
+                   .count();
+
+    last = now;
+
+    while (input_.poll(now, key)) {
+      if (key.hold) continue;
+
+      UserAction_t action = Controller::keyAction(key.key);
+
+      if (action == Terminate) {
+        running_.store(false, std::memory_order_release);
+        return;
+      }
+
+      if (action == Pause) paused = !paused;
+
+      if (action == Left || action == Right) {
+        clock = action == Right ? clock + SeekStep
+                : clock > SeekStep ? clock - SeekStep
+                                   : 0;
+
+        player.seek(clock);
+        moved = true;
+      }
+    }
+
+    while (!player.done() && player.time() <= clock) moved |= player.step();
+
+    if (moved) publish(player.info());
+
+    std::chrono::milliseconds delay(GameLoop::FrameInterval * 6);
+
+    if (!paused && !player.done() && player.time() > clock)
+      delay = std::min(delay,
+                       std::chrono::milliseconds(player.time() - clock));
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+
+    wake_.wait_for(lock, delay, [this] {
+      return stop_.load(std::memory_order_acquire) || !input_.empty();
+    });
+  }
+}
+}  // namespace s21
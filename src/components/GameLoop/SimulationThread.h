@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @brief Header of simulation thread
+ */
+
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../Concurrency/TripleBuffer.h"
+#include "../Controller/Controller.h"
+#include "../Input/InputQueue.h"
+#include "../Input/Keymap.h"
+#include "../Profiling/Latency.h"
+#include "../Replay/Replay.h"
+#include "Frame.h"
+#include "GameLoop.h"
+
+extern "C" {
+#endif
+
+#include "../../brick_game/bg_enums.h"
+#include "../../components/GameInfo/GameInfo.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Game loop running on its own thread
+ * @details The view pushes keys and takes the newest frame, the model
+ *          is only touched by the worker thread once it is started.
+ *
+ *          Every key press is timed until the model took it. One press
+ *          at a time is also followed until its frame is rendered, the
+ *          presses made meanwhile only count for the input latency.
+ *
+ *          A controller driven by a replay is played at the recorded
+ *          pace instead, the keys pause it, seek it or end it
+ */
+class SimulationThread {
+ public:
+  //! @brief Milliseconds a replay is moved by the left and right keys
+  static constexpr uint32_t SeekStep = 5000;
+
+  /**
+   * @brief Constructor
+   * @param controller Controller reference
+   * @param keymap Keymap of the view
+   * @param releases The view reports key releases
+   * @see Controller
+   */
+  SimulationThread(Controller &controller, const Keymap &keymap,
+                   bool releases);
+
+  /**
+   * @brief Destructor
+   * @details Stops and joins the worker thread
+   */
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  /**
+   * @brief Start the worker thread
+   */
+  void start();
+
+  /**
+   * @brief Stop and join the worker thread
+   * @details After the call the latency and the model are no longer
+   *          written, so they can be read from the calling thread
+   */
+  void stop();
+
+  /**
+   * @brief Pass a key event to the worker thread
+   * @param key Key code of the view
+   * @param type Event type
+   * @details The key is translated by the keymap and the event is stamped
+   *          with the current time. It is dropped if the queue is full
+   */
+  void push(int key, InputEvent::Type type = InputEvent::Press);
+
+  /**
+   * @brief Take the newest published frame
+   * @return true if a new frame was taken
+   */
+  bool update();
+
+  /**
+   * @brief Frame taken by the last update
+   * @see Frame
+   */
+  const Frame &frame() const;
+
+  /**
+   * @brief Check if the game was not terminated
+   */
+  bool running() const;
+
+  /**
+   * @brief Check if the taken frame shows a followed key first
+   * @details The view has to render it and call rendered()
+   */
+  bool awaitsRender() const;
+
+  /**
+   * @brief Stamp the frame taken by the last update as on screen
+   * @details Called by the view once the frame is rendered
+   */
+  void rendered();
+
+  /**
+   * @brief Latency of the keys
+   * @see InputLatency
+   */
+  const InputLatency &latency() const;
+
+ private:
+  /**
+   * @brief Worker thread body
+   */
+  void run();
+
+  /**
+   * @brief Worker thread body of a replay
+   * @param player Player driving the model
+   */
+  void play(ReplayPlayer &player);
+
+  /**
+   * @brief Time a key press taken by the model
+   * @param time Capture time of the key
+   */
+  void taken(GameLoop::Clock::time_point time);
+
+  /**
+   * @brief Publish game information as a new frame
+   * @param info Game information
+   */
+  void publish(GameInfo_t info);
+
+  //! @brief Controller
+  Controller &controller_;
+
+  //! @brief Keymap of the view
+  const Keymap &keymap_;
+
+  //! @brief Game loop, used by the worker thread only
+  GameLoop loop_;
+
+  //! @brief Last published score, level and high score
+  GameInfo_t shown_;
+
+  //! @brief Frames shared with the view
+  TripleBuffer<Frame> frames_;
+
+  //! @brief Key events pushed by the view
+  InputQueue input_;
+
+  //! @brief Latency of the keys
+  InputLatency latency_;
+
+  //! @brief Capture time of the followed key, used by the worker only
+  GameLoop::Clock::time_point followed_;
+
+  //! @brief Capture time of the followed key last rendered
+  std::atomic<GameLoop::Clock::rep> shownKey_;
+
+  //! @brief Capture time of the followed key of the taken frame
+  GameLoop::Clock::time_point takenKey_;
+
+  //! @brief Stop request
+  std::atomic<bool> stop_;
+
+  //! @brief Game was not terminated
+  std::atomic<bool> running_;
+
+  //! @brief Mutex of the worker sleep
+  std::mutex wakeMutex_;
+
+  //! @brief Wakes the worker on a key event or a stop request
+  std::condition_variable wake_;
+
+  //! @brief Worker thread
+  std::thread worker_;
+};
+}  // namespace s21
+
+#endif
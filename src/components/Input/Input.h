@@ -7,9 +7,6 @@
 #define INPUT_H
 
 #ifdef __cplusplus
-
-#include <Qt>
-
 extern "C" {
 #endif
 
@@ -23,11 +20,12 @@ extern "C" {
 /**
  * @brief Input processing for the user action
  * @param action User action
- * @param hold Hold action
- * @param last_key Last key
  * @param new_key New key
  * @return New key
+ *
+ * @details The key is a game key translated by the keymap of the view,
+ *          hold is timed by the input queue
  */
-int getInput(UserAction_t *action, bool *hold, int last_key, int new_key);
+int getInput(UserAction_t *action, int new_key);
 
 #endif
\ No newline at end of file
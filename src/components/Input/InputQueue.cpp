@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @brief Implementation of timestamped input queue
+ */
+
+#include "InputQueue.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+/**
+ * @brief Constructor
+ * @param shift Check if a key auto shifts when held
+ * @param releases The view reports key releases
+ */
+InputQueue::InputQueue(bool (*shift)(int key), bool releases)
+    : shift_(shift),
+      releases_(releases),
+      next_{-1, InputEvent::Press, Clock::time_point()},
+      pending_(false),
+      held_(-1),
+      shifting_(false),
+      run_(0) {}
+
+/**
+ * @brief Push key event, called by the view only
+ * @param event Key event
+ * @return false if the queue is full
+ */
+bool InputQueue::push(const InputEvent &event) { return events_.push(event); }
+
+/**
+ * @brief Take the next key due, called by the game loop only
+ * @param now Current time
+ * @param input Key to pass to the model
+ * @return false if no key is due
+ *
+ * @details Auto repeats due before the next event are taken first,
+ *          events that only keep the key held are swallowed
+ */
+bool InputQueue::poll(Clock::time_point now, KeyInput &input) {
+  for (;;) {
+    if (!pending_) pending_ = events_.pop(next_);
+
+    if (shifting_ && repeat_ <= now && (!pending_ || repeat_ <= next_.time)) {
+      if (!releases_ && repeat_ - seen_ > RepeatGap) {
+        held_ = -1;
+        shifting_ = false;
+        continue;
+      }
+
+      input = {held_, true, repeat_};
+      repeat_ += AutoRepeatRate;
+
+      return true;
+    }
+
+    if (!pending_ || next_.time > now) return false;
+
+    pending_ = false;
+
+    if (handle(next_, input)) return true;
+  }
+}
+
+/**
+ * @brief Time of the next auto repeat
+ * @return Clock::time_point::max() if no key is held
+ */
+InputQueue::Clock::time_point InputQueue::deadline() const {
+  return shifting_ ? repeat_ : Clock::time_point::max();
+}
+
+/**
+ * @brief Check if no key event is waiting
+ */
+bool InputQueue::empty() const { return !pending_ && events_.empty(); }
+
+/**
+ * @brief Apply key event to the held key
+ * @param event Key event
+ * @param input Key to pass to the model
+ * @return true if the event is a new press
+ *
+ * @details Without releases a press closer than RepeatGap to the previous
+ *          event of the same key is a terminal repeat. The second press of
+ *          a shift key still moves, as a double tap does, and the third
+ *          one starts auto shift no earlier than itself
+ */
+bool InputQueue::handle(const InputEvent &event, KeyInput &input) {
+  if (event.type == InputEvent::Release) {
+    if (event.key == held_) {
+      held_ = -1;
+      shifting_ = false;
+    }
+
+    return false;
+  }
+
+  if (event.key == held_) {
+    bool repeated = releases_ || event.type == InputEvent::Repeat ||
+                    event.time - seen_ <= RepeatGap;
+
+    if (repeated) {
+      if (!releases_ && !shifting_ && shift_(event.key)) {
+        if (++run_ == 2) {
+          seen_ = event.time;
+          input = {event.key, false, event.time};
+
+          return true;
+        }
+
+        shifting_ = true;
+        repeat_ = std::max(seen_ + AutoRepeatRate, event.time);
+      }
+
+      seen_ = event.time;
+
+      return false;
+    }
+  }
+
+  held_ = event.key;
+  seen_ = event.time;
+  shifting_ = releases_ && shift_(event.key);
+  run_ = 1;
+  repeat_ = event.time + AutoShiftDelay;
+
+  input = {event.key, false, event.time};
+
+  return true;
+}
+}  // namespace s21
@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @brief Header of timestamped input queue
+ */
+
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <chrono>
+
+#include "../Concurrency/SpscQueue.h"
+
+namespace s21 {
+
+/**
+ * @brief Key event captured by the view
+ */
+struct InputEvent {
+  /**
+   * @brief Enumeration of key event types
+   */
+  enum Type : int {
+    Press,   ///< Key went down, or a terminal repeated it
+    Repeat,  ///< Key is repeated by the window system
+    Release  ///< Key went up
+  };
+
+  //! @brief Key code
+  int key;
+
+  //! @brief Event type
+  Type type;
+
+  //! @brief Capture time
+  std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * @brief Key passed to the model
+ */
+struct KeyInput {
+  //! @brief Key code
+  int key;
+
+  //! @brief Key is held down
+  bool hold;
+
+  //! @brief Time the key takes effect
+  std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * @brief Queue of key events with delayed auto shift
+ * @details The view pushes timestamped key events, the game loop polls
+ *          the keys in time order. A held shift key is repeated after
+ *          AutoShiftDelay every AutoRepeatRate no matter how fast the
+ *          system repeats it, other keys only act when pressed.
+ *
+ *          A terminal reports no releases, so a key is held while its
+ *          repeats keep arriving less than RepeatGap apart and the
+ *          terminal repeat delay takes the place of AutoShiftDelay. Two
+ *          quick presses are a double tap, auto shift starts at the third
+ */
+class InputQueue {
+ public:
+  //! @brief Monotonic clock of the events
+  using Clock = std::chrono::steady_clock;
+
+  //! @brief Capacity of the event queue
+  static constexpr int Capacity = 256;
+
+  //! @brief Time a shift key is held before it repeats
+  static constexpr std::chrono::milliseconds AutoShiftDelay{170};
+
+  //! @brief Time between two repeats of a held shift key
+  static constexpr std::chrono::milliseconds AutoRepeatRate{50};
+
+  //! @brief Longest time between two terminal repeats of a held key
+  static constexpr std::chrono::milliseconds RepeatGap{100};
+
+  /**
+   * @brief Constructor
+   * @param shift Check if a key auto shifts when held
+   * @param releases The view reports key releases
+   */
+  InputQueue(bool (*shift)(int key), bool releases);
+
+  /**
+   * @brief Push key event, called by the view only
+   * @param event Key event
+   * @return false if the queue is full
+   */
+  bool push(const InputEvent &event);
+
+  /**
+   * @brief Take the next key due, called by the game loop only
+   * @param now Current time
+   * @param input Key to pass to the model
+   * @return false if no key is due
+   */
+  bool poll(Clock::time_point now, KeyInput &input);
+
+  /**
+   * @brief Time of the next auto repeat
+   * @return Clock::time_point::max() if no key is held
+   */
+  Clock::time_point deadline() const;
+
+  /**
+   * @brief Check if no key event is waiting
+   */
+  bool empty() const;
+
+ private:
+  /**
+   * @brief Apply key event to the held key
+   * @param event Key event
+   * @param input Key to pass to the model
+   * @return true if the event is a new press
+   */
+  bool handle(const InputEvent &event, KeyInput &input);
+
+  //! @brief Key events pushed by the view
+  SpscQueue<InputEvent, Capacity> events_;
+
+  //! @brief Check if a key auto shifts when held
+  bool (*shift_)(int key);
+
+  //! @brief The view reports key releases
+  bool releases_;
+
+  //! @brief Event taken from the queue and not handled yet
+  InputEvent next_;
+
+  //! @brief next_ holds an event
+  bool pending_;
+
+  //! @brief Held key, -1 if none
+  int held_;
+
+  //! @brief Held key auto shifts
+  bool shifting_;
+
+  //! @brief Events of the held key less than RepeatGap apart, press included
+  int run_;
+
+  //! @brief Time of the last event of the held key
+  Clock::time_point seen_;
+
+  //! @brief Time of the next auto repeat
+  Clock::time_point repeat_;
+};
+}  // namespace s21
+
+#endif
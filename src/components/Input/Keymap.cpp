@@ -0,0 +1,172 @@
+/**
+ * @file
+ * @brief Implementation of key mapping tables
+ */
+
+#include "Keymap.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace s21 {
+
+/**
+ * @brief Names of the game keys in the config file
+ */
+static const KeyName ActionNames[] = {
+    {"Up", ArrowUp},       {"Down", ArrowDown}, {"Left", ArrowLeft},
+    {"Right", ArrowRight}, {"Action", ACTION},  {"Pause", PAUSE},
+    {"Quit", QUIT},        {"Start", ENTER},    {"Stats", STATS}};
+
+//! @brief Number of the game keys
+static constexpr int ActionCount =
+    sizeof(ActionNames) / sizeof(ActionNames[0]);
+
+/**
+ * @brief Strip spaces around the string
+ * @param str String
+ */
+static std::string trim(const std::string &str) {
+  std::size_t begin = str.find_first_not_of(" \t\r");
+
+  if (begin == std::string::npos) return "";
+
+  return str.substr(begin, str.find_last_not_of(" \t\r") - begin + 1);
+}
+
+/**
+ * @brief Compare strings ignoring case
+ * @param a First string
+ * @param b Second string
+ */
+static bool sameName(const std::string &a, const char *b) {
+  std::size_t i = 0;
+
+  for (; i < a.size() && b[i]; i++)
+    if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i]))
+      return false;
+
+  return i == a.size() && !b[i];
+}
+
+/**
+ * @brief Find name in the table
+ * @param name Name
+ * @param names Table
+ * @param count Size of the table
+ * @return Index of the name, -1 if not found
+ */
+static int findName(const std::string &name, const KeyName *names,
+                    int count) {
+  for (int i = 0; i < count; i++)
+    if (sameName(name, names[i].name)) return i;
+
+  return -1;
+}
+
+/**
+ * @brief Constructor
+ * @param bindings Default bindings
+ * @param count Number of the bindings
+ */
+Keymap::Keymap(const KeyBinding *bindings, int count) {
+  for (int &code : dense_) code = Unbound;
+
+  for (int i = 0; i < count; i++) bind(bindings[i].key, bindings[i].code);
+}
+
+/**
+ * @brief Bind key to a game key
+ * @param key Key code of the view
+ * @param code Game key
+ */
+void Keymap::bind(int key, int code) {
+  if (key >= 0 && key < DenseSize)
+    dense_[key] = code;
+  else
+    sparse_[key] = code;
+}
+
+/**
+ * @brief Unbind all keys of a game key
+ * @param code Game key
+ */
+void Keymap::unbind(int code) {
+  for (int &bound : dense_)
+    if (bound == code) bound = Unbound;
+
+  for (auto it = sparse_.begin(); it != sparse_.end();)
+    it = it->second == code ? sparse_.erase(it) : std::next(it);
+}
+
+/**
+ * @brief Translate key of the view
+ * @param key Key code of the view
+ * @return Game key, Unbound if the key is not bound
+ */
+int Keymap::translate(int key) const {
+  if (key >= 0 && key < DenseSize) return dense_[key];
+
+  auto it = sparse_.find(key);
+
+  return it == sparse_.end() ? Unbound : it->second;
+}
+
+/**
+ * @brief Load bindings from the config file
+ * @param path Path to the file
+ * @param names Key names of the view
+ * @param count Number of the names
+ * @param upper Characters are bound as upper case keys
+ * @return Number of loaded bindings, -1 if the file can not be opened
+ *
+ * @details Lines that are empty, start with '#' or do not parse
+ *          are skipped
+ */
+int Keymap::load(const char *path, const KeyName *names, int count,
+                 bool upper) {
+  std::ifstream file(path);
+
+  if (!file.is_open()) return -1;
+
+  bool replaced[ActionCount] = {};
+  std::string line;
+  int loaded = 0;
+
+  while (std::getline(file, line)) {
+    std::size_t eq = line.find('=');
+
+    if (line.empty() || line[0] == '#' || eq == std::string::npos) continue;
+
+    int action = findName(trim(line.substr(0, eq)), ActionNames, ActionCount);
+    std::string name = trim(line.substr(eq + 1));
+    int key = -1;
+
+    if (name.size() == 1) {
+      key = upper ? std::toupper((unsigned char)name[0]) : name[0];
+    } else if (int index = findName(name, names, count); index != -1) {
+      key = names[index].key;
+    } else if (!name.empty()) {
+      char *end = nullptr;
+      long value = std::strtol(name.c_str(), &end, 0);
+
+      if (*end == '\0' && value >= 0) key = (int)value;
+    }
+
+    if (action == -1 || key == -1) continue;
+
+    if (!replaced[action]) {
+      unbind(ActionNames[action].key);
+      replaced[action] = true;
+    }
+
+    bind(key, ActionNames[action].key);
+    loaded++;
+  }
+
+  return loaded;
+}
+}  // namespace s21
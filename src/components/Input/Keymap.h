@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @brief Header of key mapping tables
+ */
+
+#ifndef KEYMAP_H
+#define KEYMAP_H
+
+#ifdef __cplusplus
+
+#include <unordered_map>
+
+extern "C" {
+#endif
+
+#include "../../brick_game/bg_enums.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Key of the view bound to a game key
+ */
+struct KeyBinding {
+  //! @brief Key code of the view
+  int key;
+
+  //! @brief Game key
+  Keys code;
+};
+
+/**
+ * @brief Name of a key of the view used by the config file
+ */
+struct KeyName {
+  //! @brief Name
+  const char *name;
+
+  //! @brief Key code of the view
+  int key;
+};
+
+/**
+ * @brief Table translating keys of a view to game keys
+ * @details Key codes below DenseSize are looked up in an array, the
+ *          others in a hash table, both in constant time.
+ *
+ *          The config file has one "Action = key" line per binding, where
+ *          Action is Up, Down, Left, Right, Action, Pause, Quit, Start or
+ *          Stats and key is a character, a key name of the view or a number.
+ *          The bindings of an action in the file replace its defaults
+ */
+class Keymap {
+ public:
+  //! @brief Key codes looked up in the array
+  static constexpr int DenseSize = 512;
+
+  //! @brief Game key of the unbound keys
+  static constexpr int Unbound = 0;
+
+  /**
+   * @brief Constructor
+   * @param bindings Default bindings
+   * @param count Number of the bindings
+   */
+  Keymap(const KeyBinding *bindings, int count);
+
+  /**
+   * @brief Bind key to a game key
+   * @param key Key code of the view
+   * @param code Game key
+   */
+  void bind(int key, int code);
+
+  /**
+   * @brief Unbind all keys of a game key
+   * @param code Game key
+   */
+  void unbind(int code);
+
+  /**
+   * @brief Translate key of the view
+   * @param key Key code of the view
+   * @return Game key, Unbound if the key is not bound
+   */
+  int translate(int key) const;
+
+  /**
+   * @brief Load bindings from the config file
+   * @param path Path to the file
+   * @param names Key names of the view
+   * @param count Number of the names
+   * @param upper Characters are bound as upper case keys
+   * @return Number of loaded bindings, -1 if the file can not be opened
+   */
+  int load(const char *path, const KeyName *names, int count, bool upper);
+
+ private:
+  //! @brief Game keys of the key codes below DenseSize
+  int dense_[DenseSize];
+
+  //! @brief Game keys of the other key codes
+  std::unordered_map<int, int> sparse_;
+};
+}  // namespace s21
+
+#endif
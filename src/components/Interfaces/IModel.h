@@ -8,11 +8,14 @@
 
 #ifdef __cplusplus
 
+#include <memory>
+
 extern "C" {
 #endif
 
 #include "../../brick_game/bg_enums.h"
 #include "../../components/GameInfo/GameInfo.h"
+#include "../../components/framedelta/framedelta.h"
 
 #ifdef __cplusplus
 }
@@ -48,6 +51,16 @@ class IModel {
    */
   virtual GameInfo_t updateCurrentState() = 0;
 
+  /**
+   * @brief Changes of the game since the previous call
+   * @return Changed cells and numbers
+   * @see FrameDelta
+   *
+   * @details Network mirrors and incremental renderers apply it
+   *          instead of rescanning the whole field
+   */
+  virtual const FrameDelta &updateFrameDelta() = 0;
+
   /**
    * @brief Set key for cuurent input
    * @param key Input key
@@ -66,6 +79,65 @@ class IModel {
    * @see State
    */
   virtual State getState() = 0;
+
+  /**
+   * @brief Seed the random generator of the game
+   * @param seed Seed
+   *
+   * @details The same seed and the same input give the same game
+   */
+  virtual void setSeed(uint64_t seed) = 0;
+
+  /**
+   * @brief Get the seed of the random generator
+   * @return Seed, random unless set
+   */
+  virtual uint64_t getSeed() = 0;
+
+  /**
+   * @brief Choose the randomizer of the pieces
+   * @param bagged True for the 7-bag, false for uniform draws
+   *
+   * @details Set it before the seed to reproduce a game, games without
+   *          pieces ignore it
+   */
+  virtual void setBag(bool bagged) = 0;
+
+  /**
+   * @brief Copy the game
+   * @return Independent game in the same state
+   *
+   * @details Replays keep snapshots to seek without starting over
+   */
+  virtual std::unique_ptr<IModel> snapshot() = 0;
+
+  /**
+   * @brief Take the state of a snapshot
+   * @param snapshot Snapshot of a game of the same type
+   */
+  virtual void restore(const IModel &snapshot) = 0;
+
+  /**
+   * @brief Set the leaderboard of finished games
+   * @param path Path to the leaderboard file, nullptr to skip
+   */
+  virtual void setRecords(const char *path) = 0;
+
+  /**
+   * @brief Keep the results of finished games
+   * @param persistent False skips the high score and the leaderboard
+   *
+   * @details Replayed and simulated games are not saved
+   */
+  virtual void setPersistent(bool persistent) = 0;
+
+  /**
+   * @brief Take the high score of the player from the records
+   *
+   * @details Only live games call it, replayed and simulated games start
+   *          from zero and never read the records
+   */
+  virtual void loadHighScore() = 0;
 };
 }  // namespace s21
 
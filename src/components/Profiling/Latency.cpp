@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief Implementation of input latency histograms
+ */
+
+#include "Latency.h"
+
+#include <sys/stat.h>
+
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace s21 {
+
+/**
+ * @brief Constructor
+ */
+LatencyHistogram::LatencyHistogram() {
+  for (std::atomic<std::uint32_t> &bucket : buckets_) bucket.store(0);
+}
+
+/**
+ * @brief Record duration
+ * @param duration Duration, negative ones count as zero
+ */
+void LatencyHistogram::record(std::chrono::steady_clock::duration duration) {
+  auto micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+  buckets_[bucket(micros > 0 ? micros : 0)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Number of recorded durations
+ */
+std::uint64_t LatencyHistogram::count() const {
+  std::uint64_t total = 0;
+
+  for (const std::atomic<std::uint32_t> &bucket : buckets_)
+    total += bucket.load(std::memory_order_relaxed);
+
+  return total;
+}
+
+/**
+ * @brief Duration not exceeded by the given share of the records
+ * @param share Share of the records, from 0 to 1
+ * @return Upper bound of the bucket in microseconds, 0 if empty
+ */
+std::uint64_t LatencyHistogram::percentile(double share) const {
+  std::uint64_t total = count();
+
+  if (!total) return 0;
+
+  std::uint64_t rank = (std::uint64_t)std::ceil(share * total);
+  std::uint64_t seen = 0;
+
+  if (!rank) rank = 1;
+
+  for (int i = 0; i < BucketCount - 1; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+
+    if (seen >= rank) return lowerBound(i + 1) - 1;
+  }
+
+  return lowerBound(BucketCount - 1);
+}
+
+/**
+ * @brief Bucket of the duration
+ * @param micros Duration in microseconds
+ *
+ * @details Durations below SubBuckets have a bucket each, the others
+ *          are split by their highest bit and the three bits below it
+ */
+int LatencyHistogram::bucket(std::uint64_t micros) {
+  if (micros < SubBuckets) return (int)micros;
+
+  int exponent = std::bit_width(micros) - 1;
+  int sub = (int)(micros >> (exponent - 3)) & (SubBuckets - 1);
+  int index = (exponent - 2) * SubBuckets + sub;
+
+  return index < BucketCount ? index : BucketCount - 1;
+}
+
+/**
+ * @brief Smallest duration of the bucket
+ * @param index Bucket
+ * @return Duration in microseconds
+ */
+std::uint64_t LatencyHistogram::lowerBound(int index) {
+  if (index < SubBuckets) return index;
+
+  int exponent = index / SubBuckets + 2;
+
+  return (std::uint64_t)(SubBuckets + index % SubBuckets) << (exponent - 3);
+}
+
+/**
+ * @brief Print p50 and p99 of the histograms
+ * @param out Output stream
+ * @param view Name of the view
+ */
+void InputLatency::report(std::ostream &out, const char *view) const {
+  const LatencyHistogram *histograms[] = {&input, &photon};
+  const char *names[] = {"input ", "photon"};
+
+  out << view << " latency, " << input.count() << " keys\n"
+      << std::fixed << std::setprecision(2);
+
+  for (int i = 0; i < 2; i++)
+    out << "  " << names[i] << "  p50 "
+        << histograms[i]->percentile(0.5) / 1000.0 << " ms  p99 "
+        << histograms[i]->percentile(0.99) / 1000.0 << " ms\n";
+}
+
+/**
+ * @brief Append the report to a file
+ * @param path Path to the file
+ * @param view Name of the view
+ * @return false if the file can not be written
+ */
+bool InputLatency::save(const char *path, const char *view) const {
+  mkdir("records", 0777);
+
+  std::ofstream file(path, std::ios::app);
+
+  if (!file.is_open()) return false;
+
+  report(file, view);
+
+  return true;
+}
+}  // namespace s21
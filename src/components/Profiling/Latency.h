@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief Header of input latency histograms
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace s21 {
+
+/**
+ * @brief Histogram of durations in microseconds
+ * @details Every power of two range is split into SubBuckets buckets, so
+ *          a percentile is off by at most 1 / SubBuckets. Recording is
+ *          a single relaxed atomic increment and may happen from any
+ *          thread
+ */
+class LatencyHistogram {
+ public:
+  //! @brief Buckets per power of two
+  static constexpr int SubBuckets = 8;
+
+  //! @brief Number of buckets, enough for durations up to an hour
+  static constexpr int BucketCount = 240;
+
+  /**
+   * @brief Constructor
+   */
+  LatencyHistogram();
+
+  /**
+   * @brief Record duration
+   * @param duration Duration, negative ones count as zero
+   */
+  void record(std::chrono::steady_clock::duration duration);
+
+  /**
+   * @brief Number of recorded durations
+   */
+  std::uint64_t count() const;
+
+  /**
+   * @brief Duration not exceeded by the given share of the records
+   * @param share Share of the records, from 0 to 1
+   * @return Upper bound of the bucket in microseconds, 0 if empty
+   */
+  std::uint64_t percentile(double share) const;
+
+ private:
+  /**
+   * @brief Bucket of the duration
+   * @param micros Duration in microseconds
+   */
+  static int bucket(std::uint64_t micros);
+
+  /**
+   * @brief Smallest duration of the bucket
+   * @param index Bucket
+   * @return Duration in microseconds
+   */
+  static std::uint64_t lowerBound(int index);
+
+  //! @brief Records per bucket
+  std::atomic<std::uint32_t> buckets_[BucketCount];
+};
+
+/**
+ * @brief Latency of the keys of one view
+ * @details Each key press is timed from its capture until the model has
+ *          taken it and until the first frame showing it is on screen
+ */
+struct InputLatency {
+  //! @brief From capture until Controller::userInput returned
+  LatencyHistogram input;
+
+  //! @brief From capture until the view rendered the frame
+  LatencyHistogram photon;
+
+  /**
+   * @brief Print p50 and p99 of the histograms
+   * @param out Output stream
+   * @param view Name of the view
+   */
+  void report(std::ostream &out, const char *view) const;
+
+  /**
+   * @brief Append the report to a file
+   * @param path Path to the file
+   * @param view Name of the view
+   * @return false if the file can not be written
+   */
+  bool save(const char *path, const char *view) const;
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,518 @@
+/**
+ * @file
+ * @brief Implementation of input replays
+ */
+
+#include "Replay.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <iterator>
+
+namespace s21 {
+
+//! @brief Magic bytes of the file
+static const char ReplayMagic[8] = {'B', 'G', 'R', 'E', 'P', 'L', 'A', 'Y'};
+
+/**
+ * @brief Flags of the header
+ */
+enum ReplayFlag : uint8_t {
+  ReplayBag = 1  ///< Tetris figures come from the 7-bag
+};
+
+/**
+ * @brief Kind of a record, kept in the low bits of its first varint
+ */
+enum ReplayKind : uint32_t {
+  ReplayTick,       ///< Tick, no key
+  ReplayKey,        ///< Pressed key
+  ReplayHeld,       ///< Held key
+  ReplayCheckpoint  ///< Digest of the field
+};
+
+/**
+ * @brief Append the value as a varint, 7 bits per byte
+ * @param out Output bytes
+ * @param value Value
+ */
+static void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+
+  out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Read a varint
+ * @param in Input bytes
+ * @param at Position of the varint, moved past it
+ * @param value Output value
+ * @return false if the bytes end inside the varint
+ */
+static bool getVarint(const std::string &in, size_t &at, uint64_t &value) {
+  value = 0;
+
+  for (int shift = 0; at < in.size() && shift < 64; shift += 7) {
+    uint8_t byte = static_cast<uint8_t>(in[at++]);
+
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+    if (!(byte & 0x80)) return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Create the directory of the file
+ * @param path Path to the file
+ */
+static void makeParent(const std::string &path) {
+  std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  std::error_code error;
+
+  if (!parent.empty()) std::filesystem::create_directories(parent, error);
+}
+
+/**
+ * @brief Append the header of the file
+ * @param out Output bytes
+ * @param game Game
+ * @param seed Seed of the game
+ * @param bag Tetris figures come from the 7-bag
+ */
+static void putHeader(std::string &out, ReplayGame game, uint64_t seed,
+                      bool bag) {
+  out.append(ReplayMagic, sizeof(ReplayMagic));
+  putVarint(out, Replay::Version);
+  out.push_back(static_cast<char>(game));
+  out.push_back(static_cast<char>(bag ? ReplayBag : 0));
+
+  for (int i = 0; i < 8; ++i)
+    out.push_back(static_cast<char>(seed >> (8 * i)));
+}
+
+/**
+ * @brief Append a step
+ * @param out Output bytes
+ * @param delta Milliseconds since the previous record
+ * @param key Game key, -1 for a tick
+ * @param hold Key is held down
+ *
+ * @details Keys are zigzag encoded, so the small negative codes also
+ *          take a single byte
+ */
+static void putStep(std::string &out, uint32_t delta, int key, bool hold) {
+  if (key == -1 && !hold) {
+    putVarint(out, (static_cast<uint64_t>(delta) << 2) | ReplayTick);
+    return;
+  }
+
+  uint32_t zigzag =
+      (static_cast<uint32_t>(key) << 1) ^ static_cast<uint32_t>(key >> 31);
+
+  putVarint(out, (static_cast<uint64_t>(delta) << 2) |
+                     (hold ? ReplayHeld : ReplayKey));
+  putVarint(out, zigzag);
+}
+
+/**
+ * @brief Append a checkpoint
+ * @param out Output bytes
+ * @param digest Digest of the field
+ */
+static void putCheck(std::string &out, uint32_t digest) {
+  putVarint(out, ReplayCheckpoint);
+  putVarint(out, digest);
+}
+
+/**
+ * @brief Read the replay from the file
+ * @param path Path to the file
+ * @return false if the file can not be read or is not a replay
+ *
+ * @details A record cut by a crash ends the replay. Files of version 1
+ *          have no flags and use uniform draws
+ */
+bool Replay::load(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file) return false;
+
+  std::string data{std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>()};
+  size_t at = sizeof(ReplayMagic);
+  uint64_t version = 0;
+
+  if (data.size() < at || data.compare(0, at, ReplayMagic, at) ||
+      !getVarint(data, at, version) || version < 1 || version > Version ||
+      data.size() < at + 9 + (version > 1) ||
+      static_cast<uint8_t>(data[at]) >
+          static_cast<uint8_t>(ReplayGame::Snake))
+    return false;
+
+  game = static_cast<ReplayGame>(data[at++]);
+  bag = version > 1 && (static_cast<uint8_t>(data[at++]) & ReplayBag);
+  seed = 0;
+
+  for (int i = 0; i < 8; ++i)
+    seed |= static_cast<uint64_t>(static_cast<uint8_t>(data[at++]))
+            << (8 * i);
+
+  steps.clear();
+  checks.clear();
+
+  uint32_t time = 0;
+  uint64_t head = 0, value = 0;
+
+  while (getVarint(data, at, head)) {
+    uint32_t kind = head & 3;
+
+    if (kind != ReplayTick && !getVarint(data, at, value)) break;
+
+    time += static_cast<uint32_t>(head >> 2);
+
+    if (kind == ReplayCheckpoint) {
+      checks.push_back({static_cast<uint32_t>(steps.size()),
+                        static_cast<uint32_t>(value)});
+    } else if (kind == ReplayTick) {
+      steps.push_back({time, -1, false});
+    } else {
+      int key = static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+
+      steps.push_back({time, key, kind == ReplayHeld});
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Write the replay to the file
+ * @param path Path to the file
+ * @return false if the file can not be written
+ */
+bool Replay::save(const std::string &path) const {
+  std::string data;
+  uint32_t last = 0;
+  size_t check = 0;
+
+  putHeader(data, game, seed, bag);
+
+  for (size_t i = 0; i <= steps.size(); ++i) {
+    for (; check < checks.size() && checks[check].step <= i; ++check)
+      putCheck(data, checks[check].digest);
+
+    if (i == steps.size()) break;
+
+    putStep(data, steps[i].time - last, steps[i].key, steps[i].hold);
+    last = steps[i].time;
+  }
+
+  makeParent(path);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+  file.write(data.data(), data.size());
+
+  return static_cast<bool>(file);
+}
+
+/**
+ * @brief Digest of the field
+ * @param info Game information
+ * @return FNV-1a hash of the cells
+ */
+uint32_t Replay::digest(const GameInfo_t &info) {
+  uint32_t hash = 2166136261u;
+
+  if (info.field == nullptr) return hash;
+
+  int rows = std::clamp(info.field[0][0], 0, static_cast<int>(FieldRows));
+  int cols = std::clamp(info.field[1][0], 0, static_cast<int>(FieldCols));
+
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) {
+      hash ^= static_cast<uint32_t>(info.field[i][j]);
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/**
+ * @brief Constructor
+ * @param path Path to the file, its directory is created
+ * @param game Game
+ * @param seed Seed of the game
+ * @param bag Tetris figures come from the 7-bag
+ *
+ * @details An existing file is kept, the recording takes the path with
+ *          the first free suffix -1, -2 and so on
+ */
+ReplayRecorder::ReplayRecorder(const std::string &path, ReplayGame game,
+                               uint64_t seed, bool bag)
+    : start_(Clock::now()), last_(0), steps_(0), checked_(0) {
+  int fd = -1;
+
+  makeParent(path);
+  putHeader(pending_, game, seed, bag);
+
+  for (int suffix = 0; suffix <= MaxSuffix && fd == -1; suffix++) {
+    std::string name = suffix ? path + "-" + std::to_string(suffix) : path;
+
+    fd = open(name.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+
+    if (fd != -1)
+      path_ = name;
+    else if (errno != EEXIST)
+      break;
+  }
+
+  if (fd != -1) {
+    ssize_t size = static_cast<ssize_t>(pending_.size());
+
+    if (write(fd, pending_.data(), pending_.size()) != size) path_.clear();
+
+    close(fd);
+  }
+
+  pending_.clear();
+}
+
+/**
+ * @brief Destructor
+ * @details Writes the records left
+ */
+ReplayRecorder::~ReplayRecorder() { finish(); }
+
+/**
+ * @brief Record a key fed to the game
+ * @param key Game key, -1 for a tick
+ * @param hold Key is held down
+ */
+void ReplayRecorder::record(int key, bool hold) {
+  uint32_t now = static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                            start_)
+          .count());
+
+  putStep(pending_, now - last_, key, hold);
+
+  last_ = now;
+  steps_++;
+}
+
+/**
+ * @brief Record a checkpoint if one is due
+ * @param info Game information after the last recorded step
+ *
+ * @details The records are queued for the persistence worker with the
+ *          checkpoint, the calling thread does not touch the file
+ */
+void ReplayRecorder::check(const GameInfo_t &info) {
+  if (steps_ == checked_ || steps_ % Replay::CheckpointSteps) return;
+
+  checked_ = steps_;
+
+  putCheck(pending_, Replay::digest(info));
+
+  if (!path_.empty()) PersistAppend(path_.c_str(), pending_.data(), pending_.size());
+  pending_.clear();
+}
+
+/**
+ * @brief Write the records left and wait until the file is complete
+ */
+void ReplayRecorder::finish() {
+  if (path_.empty()) return;
+
+  PersistAppend(path_.c_str(), pending_.data(), pending_.size());
+  PersistFlush();
+
+  path_.clear();
+  pending_.clear();
+}
+
+/**
+ * @brief Number of the recorded steps
+ */
+uint32_t ReplayRecorder::steps() const { return steps_; }
+
+/**
+ * @brief Path to the file
+ * @return Path with its suffix, empty if no file could be created or
+ *         after finish
+ */
+const std::string &ReplayRecorder::path() const { return path_; }
+
+/**
+ * @brief Take the values the model reports as unchanged from the earlier
+ *        game information
+ * @param info Game information, -1 values are replaced
+ * @param previous Earlier game information
+ */
+static void carry(GameInfo_t &info, const GameInfo_t &previous) {
+  if (info.high_score == -1) info.high_score = previous.high_score;
+  if (info.score == -1) info.score = previous.score;
+  if (info.level == -1) info.level = previous.level;
+}
+
+/**
+ * @brief Constructor
+ * @param controller Controller of a new game of the replay
+ * @param replay Replay, kept by reference
+ */
+ReplayPlayer::ReplayPlayer(Controller &controller, const Replay &replay)
+    : controller_(controller),
+      replay_(replay),
+      position_(0),
+      check_(0),
+      ended_(false),
+      diverged_(-1) {
+  controller_.setBag(replay_.bag);
+  controller_.setSeed(replay_.seed);
+  controller_.setPersistent(false);
+
+  info_ = controller_.updateCurrentState();
+
+  snapshots_.push_back(controller_.snapshot());
+  shown_.push_back(info_);
+}
+
+/**
+ * @brief Play the next step
+ * @return false if the replay ended
+ *
+ * @details A terminate key ends the replay without passing it to the
+ *          model, so the played game is not saved
+ */
+bool ReplayPlayer::step() {
+  if (done()) return false;
+
+  const ReplayStep &step = replay_.steps[position_];
+  UserAction_t action = Start;
+
+  controller_.getInput(&action, step.key);
+
+  if (action == Terminate) {
+    ended_ = true;
+    return false;
+  }
+
+  controller_.userInput(action, step.hold);
+
+  GameInfo_t info = controller_.updateCurrentState();
+
+  carry(info, info_);
+  info_ = info;
+  position_++;
+
+  for (; check_ < replay_.checks.size() &&
+         replay_.checks[check_].step <= position_;
+       ++check_)
+    if (replay_.checks[check_].step == position_ &&
+        replay_.checks[check_].digest != Replay::digest(info) &&
+        diverged_ == -1)
+      diverged_ = static_cast<long>(check_);
+
+  if (position_ % Replay::CheckpointSteps == 0 &&
+      snapshots_.size() == position_ / Replay::CheckpointSteps) {
+    snapshots_.push_back(controller_.snapshot());
+    shown_.push_back(info_);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Play the steps up to the position at full speed
+ * @param position Number of the steps played after the call
+ * @return Number of the steps played
+ */
+size_t ReplayPlayer::run(size_t position) {
+  size_t played = 0;
+
+  while (position_ < position && step()) played++;
+
+  return played;
+}
+
+/**
+ * @brief Move the playback to the time
+ * @param time Milliseconds since the start of the recording
+ *
+ * @details The game is restored from the last copy before the time
+ *          and the steps after it are played at full speed
+ */
+void ReplayPlayer::seek(uint32_t time) {
+  const std::vector<ReplayStep> &steps = replay_.steps;
+  size_t target =
+      std::lower_bound(steps.begin(), steps.end(), time,
+                       [](const ReplayStep &step, uint32_t value) {
+                         return step.time < value;
+                       }) -
+      steps.begin();
+  size_t snapshot = std::min(target / Replay::CheckpointSteps,
+                             snapshots_.size() - 1);
+
+  if (target < position_ || snapshot > position_ / Replay::CheckpointSteps) {
+    controller_.restore(*snapshots_[snapshot]);
+
+    info_ = controller_.updateCurrentState();
+    carry(info_, shown_[snapshot]);
+
+    position_ = snapshot * Replay::CheckpointSteps;
+    ended_ = false;
+    check_ = 0;
+
+    while (check_ < replay_.checks.size() &&
+           replay_.checks[check_].step <= position_)
+      check_++;
+  }
+
+  run(target);
+}
+
+/**
+ * @brief Check if the replay ended
+ */
+bool ReplayPlayer::done() const {
+  return ended_ || position_ >= replay_.steps.size();
+}
+
+/**
+ * @brief Number of the played steps
+ */
+size_t ReplayPlayer::position() const { return position_; }
+
+/**
+ * @brief Time of the next step, or of the last one at the end
+ * @return Milliseconds since the start of the recording
+ */
+uint32_t ReplayPlayer::time() const {
+  if (replay_.steps.empty()) return 0;
+
+  return replay_.steps[std::min(position_, replay_.steps.size() - 1)].time;
+}
+
+/**
+ * @brief First checkpoint the game did not match
+ * @return Index of the checkpoint, -1 if all played ones matched
+ */
+long ReplayPlayer::diverged() const { return diverged_; }
+
+/**
+ * @brief Game information after the last played step
+ * @return Game information, values the model reports as unchanged (-1)
+ *         are carried forward from the earlier steps
+ */
+const GameInfo_t &ReplayPlayer::info() const { return info_; }
+}  // namespace s21
@@ -0,0 +1,301 @@
+/**
+ * @file
+ * @brief Header of input replays
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#ifdef __cplusplus
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Controller/Controller.h"
+#include "../Interfaces/IModel.h"
+
+extern "C" {
+#endif
+
+#include "../../brick_game/bg_enums.h"
+#include "../../components/GameInfo/GameInfo.h"
+#include "../../components/persist/persist.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Key fed to the game
+ */
+struct ReplayStep {
+  uint32_t time;  ///< Milliseconds since the start of the recording
+  int key;        ///< Game key, -1 for a tick
+  bool hold;      ///< Key is held down
+};
+
+/**
+ * @brief Digest of the field after a number of steps
+ */
+struct ReplayCheck {
+  uint32_t step;    ///< Steps played before the digest was taken
+  uint32_t digest;  ///< Digest of the field
+};
+
+/**
+ * @brief Game of a replay
+ */
+enum class ReplayGame : uint8_t {
+  Tetris,  ///< Tetris game
+  Snake    ///< Snake game
+};
+
+/**
+ * @brief Recorded game
+ * @details The models are deterministic, so a game is its seed and the
+ *          keys and ticks fed to Controller::userInput.
+ *
+ *          The file holds the header, the magic bytes, a version, the game,
+ *          the flags of the randomizer and the seed, followed by records of
+ *          varints. A record starts
+ *          with the time since the previous record shifted left by two
+ *          bits and its kind in the low bits: a tick, a key, a held key
+ *          followed by the zigzag encoded key, or a checkpoint followed
+ *          by the digest. A tick takes one or two bytes
+ */
+class Replay {
+ public:
+  //! @brief Version of the file format
+  static constexpr int Version = 2;
+
+  //! @brief Steps between two checkpoints
+  static constexpr uint32_t CheckpointSteps = 256;
+
+  //! @brief Game
+  ReplayGame game = ReplayGame::Tetris;
+
+  //! @brief Seed of the game
+  uint64_t seed = 0;
+
+  //! @brief Tetris figures come from the 7-bag
+  bool bag = false;
+
+  //! @brief Keys and ticks in the order they were fed
+  std::vector<ReplayStep> steps;
+
+  //! @brief Digests of the field every CheckpointSteps steps
+  std::vector<ReplayCheck> checks;
+
+  /**
+   * @brief Read the replay from the file
+   * @param path Path to the file
+   * @return false if the file can not be read or is not a replay
+   *
+   * @details A record cut by a crash ends the replay
+   */
+  bool load(const std::string &path);
+
+  /**
+   * @brief Write the replay to the file
+   * @param path Path to the file
+   * @return false if the file can not be written
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * @brief Digest of the field
+   * @param info Game information
+   * @return FNV-1a hash of the cells
+   */
+  static uint32_t digest(const GameInfo_t &info);
+};
+
+/**
+ * @brief Writer of the keys fed to the game
+ * @details The records are handed to the persistence worker at every
+ *          checkpoint, so the game thread does not write the file and a
+ *          crash loses at most the last CheckpointSteps steps. The game
+ *          waits only if the worker falls behind and its queue is full
+ */
+class ReplayRecorder {
+ public:
+  //! @brief Monotonic clock of the recording
+  using Clock = std::chrono::steady_clock;
+
+  //! @brief Most suffixes tried for the name of a new file
+  static constexpr int MaxSuffix = 100;
+
+  /**
+   * @brief Constructor
+   * @param path Path to the file, its directory is created
+   * @param game Game
+   * @param seed Seed of the game
+   * @param bag Tetris figures come from the 7-bag
+   *
+   * @details An existing file is kept, the recording takes the path with
+   *          the first free suffix -1, -2 and so on
+   */
+  ReplayRecorder(const std::string &path, ReplayGame game, uint64_t seed,
+                 bool bag = false);
+
+  /**
+   * @brief Destructor
+   * @details Writes the records left
+   */
+  ~ReplayRecorder();
+
+  ReplayRecorder(const ReplayRecorder &) = delete;
+  ReplayRecorder &operator=(const ReplayRecorder &) = delete;
+
+  /**
+   * @brief Record a key fed to the game
+   * @param key Game key, -1 for a tick
+   * @param hold Key is held down
+   */
+  void record(int key, bool hold);
+
+  /**
+   * @brief Record a checkpoint if one is due
+   * @param info Game information after the last recorded step
+   */
+  void check(const GameInfo_t &info);
+
+  /**
+   * @brief Write the records left and wait until the file is complete
+   */
+  void finish();
+
+  /**
+   * @brief Number of the recorded steps
+   */
+  uint32_t steps() const;
+
+  /**
+   * @brief Path to the file
+   * @return Path with its suffix, empty if no file could be created or
+   *         after finish
+   */
+  const std::string &path() const;
+
+ private:
+  //! @brief Path to the file, empty after finish
+  std::string path_;
+
+  //! @brief Records not written yet
+  std::string pending_;
+
+  //! @brief Start of the recording
+  Clock::time_point start_;
+
+  //! @brief Time of the previous record, in milliseconds
+  uint32_t last_;
+
+  //! @brief Number of the recorded steps
+  uint32_t steps_;
+
+  //! @brief Steps recorded at the last checkpoint
+  uint32_t checked_;
+};
+
+/**
+ * @brief Player of a replay through a controller
+ * @details The game takes the randomizer and the seed of the replay and
+ *          the steps are fed to the controller as
+ *          GameLoop does. The model is copied at every checkpoint, so a
+ *          seek replays at most CheckpointSteps steps. Played games are
+ *          not saved, neither the high score nor the leaderboard
+ */
+class ReplayPlayer {
+ public:
+  /**
+   * @brief Constructor
+   * @param controller Controller of a new game of the replay
+   * @param replay Replay, kept by reference
+   */
+  ReplayPlayer(Controller &controller, const Replay &replay);
+
+  /**
+   * @brief Play the next step
+   * @return false if the replay ended
+   */
+  bool step();
+
+  /**
+   * @brief Play the steps up to the position at full speed
+   * @param position Number of the steps played after the call
+   * @return Number of the steps played
+   */
+  size_t run(size_t position);
+
+  /**
+   * @brief Move the playback to the time
+   * @param time Milliseconds since the start of the recording
+   */
+  void seek(uint32_t time);
+
+  /**
+   * @brief Check if the replay ended
+   */
+  bool done() const;
+
+  /**
+   * @brief Number of the played steps
+   */
+  size_t position() const;
+
+  /**
+   * @brief Time of the next step, or of the last one at the end
+   * @return Milliseconds since the start of the recording
+   */
+  uint32_t time() const;
+
+  /**
+   * @brief First checkpoint the game did not match
+   * @return Index of the checkpoint, -1 if all played ones matched
+   */
+  long diverged() const;
+
+  /**
+   * @brief Game information after the last played step
+   * @return Game information, values the model reports as unchanged (-1)
+   *         are carried forward from the earlier steps
+   */
+  const GameInfo_t &info() const;
+
+ private:
+  //! @brief Controller of the played game
+  Controller &controller_;
+
+  //! @brief Replay
+  const Replay &replay_;
+
+  //! @brief Number of the played steps
+  size_t position_;
+
+  //! @brief Next checkpoint to compare
+  size_t check_;
+
+  //! @brief The replay ended by a terminate key
+  bool ended_;
+
+  //! @brief First checkpoint the game did not match
+  long diverged_;
+
+  //! @brief Copies of the model, one every CheckpointSteps steps
+  std::vector<std::unique_ptr<IModel>> snapshots_;
+
+  //! @brief Game information after the last played step
+  GameInfo_t info_;
+
+  //! @brief Game information of every copy of the model
+  std::vector<GameInfo_t> shown_;
+};
+}  // namespace s21
+
+#endif
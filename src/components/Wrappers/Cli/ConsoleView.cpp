@@ -5,12 +5,28 @@
 
 #include "ConsoleView.h"
 
-#include <time.h>
-
+#include <iterator>
 #include <locale>
 
 namespace s21 {
 
+/**
+ * @brief Default key bindings of the console
+ */
+static const KeyBinding ConsoleBindings[] = {
+    {KEY_UP, ArrowUp},       {KEY_DOWN, ArrowDown}, {KEY_LEFT, ArrowLeft},
+    {KEY_RIGHT, ArrowRight}, {'\n', ENTER},         {'q', QUIT},
+    {'p', PAUSE},            {' ', ACTION},         {KEY_F(12), STATS}};
+
+/**
+ * @brief Key names of the console
+ */
+static const KeyName ConsoleNames[] = {
+    {"Up", KEY_UP},       {"Down", KEY_DOWN}, {"Left", KEY_LEFT},
+    {"Right", KEY_RIGHT}, {"Enter", '\n'},    {"Space", ' '},
+    {"Tab", '\t'},        {"Escape", 27},     {"Backspace", KEY_BACKSPACE},
+    {"F12", KEY_F(12)}};
+
 /**
  * @brief Constructor
  * @param controller_ Controller reference
@@ -24,42 +40,65 @@ ConsoleView::ConsoleView(Controller &controller) : controller_(controller) {}
  * @param code Rendering code
  */
 int ConsoleView::render(GameInfo_t &gameInfo, int code) {
+  TraceScope trace("render");
+
   return ::render(&gameInfo, code);
 }
 
 /**
  * @brief Start game event loop
+ * @details The game runs on a simulation thread, this loop passes it
+ *          all pending keys and renders its newest frame. The terminal
+ *          reports no key releases, the thread infers holds from repeats.
+ *          Key bindings are read from KeymapPath if it exists. Key
+ *          latency is appended to LatencyPath on exit and on the Stats key,
+ *          which also writes the trace to TracePath
  */
 int ConsoleView::startEventLoop() {
   setlocale(LC_ALL, "");
-  srand(time(0));
 
   ncursesInit();
 
-  UserAction_t action = Start;
+  Keymap keymap(ConsoleBindings, std::size(ConsoleBindings));
+
+  keymap.load(KeymapPath, ConsoleNames, std::size(ConsoleNames), false);
 
-  bool hold = false;
+  SimulationThread simulation(controller_, keymap, false);
+
+  simulation.start();
 
   int code = 1;
 
-  while (code) {
+  while (code && simulation.running()) {
+    timeout(GameLoop::FrameInterval);
+
     int key = getch();
 
-    controller_.getInput(&action, &hold, key);
-    controller_.userInput(action, hold);
+    if (key != ERR) timeout(0);
 
-    if (action == Terminate) {
-      endwin();
-      break;
+    for (; key != ERR; key = getch()) {
+      if (keymap.translate(key) == STATS) {
+        simulation.latency().save(LatencyPath, "console");
+        TraceWrite(TracePath);
+      } else
+        simulation.push(key);
     }
 
-    GameInfo_t gameInfo = controller_.updateCurrentState();
+    if (simulation.update()) {
+      const Frame &frame = simulation.frame();
+      GameInfo_t gameInfo = frame.info();
 
-    code = render(gameInfo, controller_.getStateCode());
+      code = render(gameInfo, frame.code());
 
-    timeout(gameInfo.speed);
+      simulation.rendered();
+    }
   }
 
+  if (code) endwin();
+
+  simulation.stop();
+  simulation.latency().save(LatencyPath, "console");
+
   return 0;
 }
 }  // namespace s21
\ No newline at end of file
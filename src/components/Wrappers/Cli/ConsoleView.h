@@ -9,6 +9,7 @@
 #ifdef __cplusplus
 
 #include "../../Controller/Controller.h"
+#include "../../GameLoop/SimulationThread.h"
 #include "../../Interfaces/IView.h"
 
 extern "C" {
@@ -32,6 +33,15 @@ class ConsoleView : public IView {
   Controller& controller_;
 
  public:
+  //! @brief Path to the key bindings of the console
+  static constexpr const char* KeymapPath = "keymap/console";
+
+  //! @brief Path to the key latency report
+  static constexpr const char* LatencyPath = "records/latency";
+
+  //! @brief Path to the Chrome trace
+  static constexpr const char* TracePath = "records/trace.json";
+
   /**
    * @brief Constructor
    * @param controller_ Controller reference
@@ -41,6 +51,12 @@ class ConsoleView : public IView {
 
   /**
    * @brief Start game event loop
+   * @details The game runs on a simulation thread, this loop passes it
+   *          all pending keys and renders its newest frame. The terminal
+   *          reports no key releases, the thread infers holds from repeats.
+   *          Key bindings are read from KeymapPath if it exists. Key
+   *          latency is appended to LatencyPath on exit and on the Stats key,
+   *          which also writes the trace to TracePath
    */
   int startEventLoop() override;
 
@@ -10,10 +10,12 @@ namespace s21 {
 /**
  * @brief Constructor
  * @param controller Controller reference
+ * @param backend Field rendering backend
  * @see Controller
  */
-DesktopViewWrapper::DesktopViewWrapper(Controller &controller)
-    : controller(controller) {}
+DesktopViewWrapper::DesktopViewWrapper(Controller &controller,
+                                       RenderBackend backend)
+    : controller(controller), backend(backend) {}
 
 /**
  * @brief Launch desktop qt view
@@ -25,9 +27,8 @@ int DesktopViewWrapper::startEventLoop() {
   QApplication app(argc, argv);
 
   std::setlocale(LC_NUMERIC, "C");
-  srand(time(0));
 
-  DesktopView view(controller);
+  DesktopView view(controller, backend);
 
   view.setWindowTitle("BrickGame");
 
@@ -35,13 +35,18 @@ class DesktopViewWrapper : public IView {
   //! @brief Controller pointer
   Controller &controller;
 
+  //! @brief Field rendering backend
+  RenderBackend backend;
+
  public:
   /**
    * @brief Constructor
    * @param controller Controller reference
+   * @param backend Field rendering backend
    * @see Controller
    */
-  DesktopViewWrapper(Controller &controller);
+  DesktopViewWrapper(Controller &controller,
+                     RenderBackend backend = RenderBackend::Scene);
 
   /**
    * @brief Launch desktop qt view
@@ -10,15 +10,30 @@ namespace s21 {
 /**
  * @brief Constructor
  */
-TetrisModel::TetrisModel() {
-  ::TetrisGameInit();
-  ::TetrisGameInfoInit();
-}
+TetrisModel::TetrisModel() : context_{} { ::TetrisContextInit(&context_); }
 
 /**
  * @brief Destructor
  */
-TetrisModel::~TetrisModel() { ::DeleteGameInfo(); }
+TetrisModel::~TetrisModel() { ::TetrisContextDestroy(&context_); }
+
+/**
+ * @brief Copy constructor
+ * @param other Game to copy
+ */
+TetrisModel::TetrisModel(const TetrisModel &other) : TetrisModel() {
+  ::TetrisContextCopy(&context_, &other.context_);
+}
+
+/**
+ * @brief Copy assignment
+ * @param other Game to copy
+ */
+TetrisModel &TetrisModel::operator=(const TetrisModel &other) {
+  if (this != &other) ::TetrisContextCopy(&context_, &other.context_);
+
+  return *this;
+}
 
 /**
  * @brief User input accepts a user action as input
@@ -29,7 +44,7 @@ TetrisModel::~TetrisModel() { ::DeleteGameInfo(); }
  * @details Is the entry point into the game logic
  */
 void TetrisModel::userInput(UserAction_t action, bool hold) {
-  ::userInput(action, hold);
+  ::TetrisUserInput(&context_, action, hold);
 }
 
 /**
@@ -39,24 +54,104 @@ void TetrisModel::userInput(UserAction_t action, bool hold) {
  *
  * @details The view uses a structure for rendering
  */
-GameInfo_t TetrisModel::updateCurrentState() { return ::updateCurrentState(); }
+GameInfo_t TetrisModel::updateCurrentState() {
+  return ::TetrisUpdateCurrentState(&context_);
+}
+
+/**
+ * @brief Changes of the game since the previous call
+ * @return Changed cells and numbers
+ * @see FrameDelta
+ */
+const FrameDelta &TetrisModel::updateFrameDelta() {
+  return *::TetrisUpdateFrameDelta(&context_);
+}
 
 /**
  * @brief Set key for cuurent input
  * @param key Input key
  */
-void TetrisModel::setKey(int key) { ::setKey(key); }
+void TetrisModel::setKey(int key) { ::TetrisSetKey(&context_, key); }
 
 /**
  * @brief Get last input key
  * @return Last key
  */
-int TetrisModel::getLastKey() { return ::getTetrisLastKey(); }
+int TetrisModel::getLastKey() { return ::TetrisGetLastKey(&context_); }
 
 /**
  * @brief Get current state of the game
  * @return Current state
  * @see State
  */
-State TetrisModel::getState() { return ::getTetrisState(); }
+State TetrisModel::getState() { return ::TetrisGetState(&context_); }
+
+/**
+ * @brief Seed the random generator of the game
+ * @param seed Seed
+ *
+ * @details The same seed and the same input give the same game
+ */
+void TetrisModel::setSeed(uint64_t seed) { ::TetrisSetSeed(&context_, seed); }
+
+/**
+ * @brief Get the seed of the random generator
+ * @return Seed, random unless set
+ */
+uint64_t TetrisModel::getSeed() { return ::TetrisGetSeed(&context_); }
+
+/**
+ * @brief Choose the randomizer of the figures
+ * @param bagged True for the 7-bag, false for uniform draws
+ *
+ * @details Set it before the seed to reproduce a game
+ */
+void TetrisModel::setBag(bool bagged) { ::TetrisSetBag(&context_, bagged); }
+
+/**
+ * @brief Copy the game
+ * @return Independent game in the same state
+ *
+ * @details Replays keep snapshots to seek without starting over
+ */
+std::unique_ptr<IModel> TetrisModel::snapshot() {
+  return std::make_unique<TetrisModel>(*this);
+}
+
+/**
+ * @brief Take the state of a snapshot
+ * @param snapshot Snapshot of a game of the same type
+ */
+void TetrisModel::restore(const IModel &snapshot) {
+  *this = dynamic_cast<const TetrisModel &>(snapshot);
+}
+
+/**
+ * @brief Set the leaderboard of finished games
+ * @param path Path to the leaderboard file, nullptr to skip
+ */
+void TetrisModel::setRecords(const char *path) { context_.records = path; }
+
+/**
+ * @brief Keep the results of finished games
+ * @param persistent False skips the high score and the leaderboard
+ */
+void TetrisModel::setPersistent(bool persistent) {
+  context_.persistent = persistent;
+}
+
+/**
+ * @brief Take the high score of the player from the records
+ */
+void TetrisModel::loadHighScore() { ::TetrisLoadHighScore(&context_); }
+
+/**
+ * @brief Get rows removed by the last attached figure
+ * @return Bit i is set if row i of the field was removed
+ *
+ * @details Lets the view animate removed lines without rescanning
+ */
+uint32_t TetrisModel::getClearedRows() const {
+  return ::TetrisGetClearedRows(&context_);
+}
 }  // namespace s21
\ No newline at end of file
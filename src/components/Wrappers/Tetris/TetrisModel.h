@@ -26,6 +26,9 @@ namespace s21 {
  * @see IModel
  */
 class TetrisModel : public IModel {
+  //! @brief Game context of this instance
+  TetrisContext context_;
+
  public:
   /**
    * @brief Constructor
@@ -37,6 +40,18 @@ class TetrisModel : public IModel {
    */
   ~TetrisModel() override;
 
+  /**
+   * @brief Copy constructor
+   * @param other Game to copy
+   */
+  TetrisModel(const TetrisModel &other);
+
+  /**
+   * @brief Copy assignment
+   * @param other Game to copy
+   */
+  TetrisModel &operator=(const TetrisModel &other);
+
   /**
    * @brief User input accepts a user action as input
    * @param action User action
@@ -56,6 +71,16 @@ class TetrisModel : public IModel {
    */
   GameInfo_t updateCurrentState() override;
 
+  /**
+   * @brief Changes of the game since the previous call
+   * @return Changed cells and numbers
+   * @see FrameDelta
+   *
+   * @details Network mirrors and incremental renderers apply it
+   *          instead of rescanning the whole field
+   */
+  const FrameDelta &updateFrameDelta() override;
+
   /**
    * @brief Set key for cuurent input
    * @param key Input key
@@ -74,6 +99,69 @@ class TetrisModel : public IModel {
    * @see State
    */
   State getState() override;
+
+  /**
+   * @brief Seed the random generator of the game
+   * @param seed Seed
+   *
+   * @details The same seed and the same input give the same game
+   */
+  void setSeed(uint64_t seed) override;
+
+  /**
+   * @brief Get the seed of the random generator
+   * @return Seed, random unless set
+   */
+  uint64_t getSeed() override;
+
+  /**
+   * @brief Choose the randomizer of the figures
+   * @param bagged True for the 7-bag, false for uniform draws
+   *
+   * @details Set it before the seed to reproduce a game
+   */
+  void setBag(bool bagged) override;
+
+  /**
+   * @brief Copy the game
+   * @return Independent game in the same state
+   *
+   * @details Replays keep snapshots to seek without starting over
+   */
+  std::unique_ptr<IModel> snapshot() override;
+
+  /**
+   * @brief Take the state of a snapshot
+   * @param snapshot Snapshot of a game of the same type
+   */
+  void restore(const IModel &snapshot) override;
+
+  /**
+   * @brief Set the leaderboard of finished games
+   * @param path Path to the leaderboard file, nullptr to skip
+   */
+  void setRecords(const char *path) override;
+
+  /**
+   * @brief Keep the results of finished games
+   * @param persistent False skips the high score and the leaderboard
+   *
+   * @details Replayed and simulated games are not saved
+   */
+  void setPersistent(bool persistent) override;
+
+  /**
+   * @brief Take the high score of the player from the records
+   */
+  void loadHighScore() override;
+
+  /**
+   * @brief Get rows removed by the last attached figure
+   * @return Bit i is set if row i of the field was removed
+   *
+   * @details Lets the view animate removed lines without rescanning
+   */
+  uint32_t getClearedRows() const;
 };
 }  // namespace s21
 
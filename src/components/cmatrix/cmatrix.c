@@ -4,22 +4,45 @@
 */
 #include "cmatrix.h"
 
+#include <string.h>
+
+/*!
+    @brief Round a size up to the matrix alignment
+    @param size Size in bytes
+    @return Aligned size
+*/
+static size_t AlignSize(size_t size) {
+  return (size + MatrixAlign - 1) / MatrixAlign * MatrixAlign;
+}
+
 /*!
     @brief Create matrix
     @param rows Number of rows
     @param columns Number of columns
     @param matrix Pointer to matrix
+    @return 0 on success
 */
 int CreateMatrix(int rows, int columns, int ***matrix) {
   int code = 1;
 
   if (rows > 0 && columns > 0) {
-    *matrix = (int **)calloc(rows, sizeof(int *));
+    size_t table = AlignSize(rows * sizeof(int *));
+    size_t size = AlignSize(table + (size_t)rows * columns * sizeof(int));
+
+    char *block = (char *)aligned_alloc(MatrixAlign, size);
 
-    for (int i = 0; i < rows; i++)
-      (*matrix)[i] = (int *)calloc(columns, sizeof(int));
+    if (block != NULL) {
+      memset(block, 0, size);
 
-    code = 0;
+      int **row_table = (int **)block;
+      int *cells = (int *)(block + table);
+
+      for (int i = 0; i < rows; i++) row_table[i] = cells + i * columns;
+
+      *matrix = row_table;
+
+      code = 0;
+    }
   }
 
   return code;
@@ -31,11 +54,7 @@ int CreateMatrix(int rows, int columns, int ***matrix) {
     @param rows Number of rows
 */
 void RemoveMatrix(int **matrix, int rows) {
-  if (matrix) {
-    for (int i = 0; i < rows; i++) free(matrix[i]);
+  (void)rows;
 
-    free(matrix);
-
-    matrix = NULL;
-  }
-}
\ No newline at end of file
+  free(matrix);
+}
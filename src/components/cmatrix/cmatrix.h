@@ -8,11 +8,23 @@
 
 #include <stdlib.h>
 
+/// Matrix memory layout
+typedef enum {
+
+  MatrixAlign = 64  ///< Alignment of the cells, one cache line
+
+} MatrixLayout;
+
 /*!
     @brief Create matrix
     @param rows Number of rows
     @param columns Number of columns
     @param matrix Pointer to matrix
+    @return 0 on success
+
+    The row table and the cells share one allocation, cells are
+    contiguous and start on a cache line, so matrix[0] addresses
+    the whole matrix row by row
 */
 int CreateMatrix(int rows, int columns, int ***matrix);
 
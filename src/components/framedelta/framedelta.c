@@ -0,0 +1,145 @@
+/*!
+    @file
+    @brief Changes of the game information between two frames
+*/
+#include "framedelta.h"
+
+#include <limits.h>
+
+#include "../cmatrix/cmatrix.h"
+
+/*!
+    @brief Initialize the tracker
+    @param tracker Tracker
+    @param rows Rows of the field
+    @param cols Columns of the field
+    @return 0 on success
+
+    The first delta reports every cell and number
+*/
+int DeltaTrackerInit(DeltaTracker *tracker, int rows, int cols) {
+  tracker->shadow = NULL;
+
+  if (rows > DeltaMaxRows || rows * cols > DeltaMaxCells) return 1;
+
+  if (CreateMatrix(rows, cols, &tracker->shadow)) return 1;
+
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) tracker->shadow[i][j] = INT_MIN;
+
+  tracker->rows = rows;
+  tracker->cols = cols;
+  tracker->touched = rows == 32 ? UINT32_MAX : (1u << rows) - 1;
+
+  tracker->reported.score = INT_MIN;
+  tracker->reported.high_score = INT_MIN;
+  tracker->reported.level = INT_MIN;
+  tracker->reported.speed = INT_MIN;
+  tracker->reported.pause = INT_MIN;
+  tracker->next = INT_MIN;
+  tracker->next_color = INT_MIN;
+
+  tracker->delta.count = 0;
+
+  return 0;
+}
+
+/*!
+    @brief Release the tracker
+    @param tracker Tracker
+*/
+void DeltaTrackerDestroy(DeltaTracker *tracker) {
+  if (tracker->shadow) RemoveMatrix(tracker->shadow, tracker->rows);
+
+  tracker->shadow = NULL;
+}
+
+/*!
+    @brief Copy the tracker into another one of the same size
+    @param dst Initialized tracker
+    @param src Tracker to copy
+*/
+void DeltaTrackerCopy(DeltaTracker *dst, const DeltaTracker *src) {
+  int **shadow = dst->shadow;
+
+  *dst = *src;
+  dst->shadow = shadow;
+
+  for (int i = 0; i < src->rows; i++)
+    for (int j = 0; j < src->cols; j++) shadow[i][j] = src->shadow[i][j];
+}
+
+/*!
+    @brief Mark rows as written
+    @param tracker Tracker
+    @param rows Bit i is set if row i was written
+*/
+void DeltaTouchRows(DeltaTracker *tracker, uint32_t rows) {
+  tracker->touched |= rows;
+}
+
+/*!
+    @brief Report a number if it changed
+    @param reported Number as of the previous delta
+    @param value Current number, -1 if the game did not send it
+    @return Number for the delta
+*/
+static int DeltaNumber(int *reported, int value) {
+  if (value == -1 || value == *reported) return -1;
+
+  *reported = value;
+
+  return value;
+}
+
+/*!
+    @brief Collect the changes since the previous delta
+    @param tracker Tracker
+    @param info Current game information
+    @return Delta owned by the tracker
+*/
+const FrameDelta *DeltaCollect(DeltaTracker *tracker, const GameInfo_t *info) {
+  FrameDelta *delta = &tracker->delta;
+  uint32_t touched = info->field ? tracker->touched : 0;
+
+  delta->count = 0;
+
+  while (touched) {
+    int i = __builtin_ctz(touched);
+    const int *row = info->field[i];
+    int *shadow = tracker->shadow[i];
+
+    for (int j = 0; j < tracker->cols; j++) {
+      if (row[j] == shadow[j]) continue;
+
+      CellChange *cell = &delta->cells[delta->count++];
+
+      cell->row = (uint8_t)i;
+      cell->col = (uint8_t)j;
+      cell->value = (int16_t)row[j];
+
+      shadow[j] = row[j];
+    }
+
+    touched &= touched - 1;
+  }
+
+  if (info->field) tracker->touched = 0;
+
+  delta->score = DeltaNumber(&tracker->reported.score, info->score);
+  delta->high_score =
+      DeltaNumber(&tracker->reported.high_score, info->high_score);
+  delta->level = DeltaNumber(&tracker->reported.level, info->level);
+  delta->speed = DeltaNumber(&tracker->reported.speed, info->speed);
+  delta->pause = DeltaNumber(&tracker->reported.pause, info->pause);
+
+  delta->next = -1;
+  delta->next_color = -1;
+
+  if (info->next) {
+    delta->next = DeltaNumber(&tracker->next, info->next[0][4]);
+    delta->next_color = DeltaNumber(&tracker->next_color, info->next[0][5]);
+  }
+
+  return delta;
+}
@@ -0,0 +1,106 @@
+/*!
+    @file
+    @brief Changes of the game information between two frames
+*/
+
+#ifndef FRAMEDELTA_H
+#define FRAMEDELTA_H
+
+#include <stdint.h>
+
+#include "../../brick_game/bg_enums.h"
+#include "../GameInfo/GameInfo.h"
+
+/// Frame delta limits
+typedef enum {
+
+  DeltaMaxRows = 32,                     ///< Rows a tracker can follow
+  DeltaMaxCells = FieldRows * FieldCols  ///< Cells of the largest field
+
+} DeltaLimits;
+
+/// Changed cell of the field
+typedef struct {
+  uint8_t row;    ///< Row of the cell
+  uint8_t col;    ///< Column of the cell
+  int16_t value;  ///< New value of the cell
+
+} CellChange;
+
+/*!
+    @brief Changes since the previous delta
+
+    Numbers that did not change are -1, next is -1 for games
+    without a next figure
+*/
+typedef struct {
+  CellChange cells[DeltaMaxCells];  ///< Changed cells
+  int count;                        ///< Number of changed cells
+  int score;                        ///< Score
+  int high_score;                   ///< High score
+  int level;                        ///< Level
+  int speed;                        ///< Speed
+  int pause;                        ///< Pause
+  int next;                         ///< Next figure
+  int next_color;                   ///< Color of the next figure
+
+} FrameDelta;
+
+/*!
+    @brief Source of frame deltas of one field
+
+    Engines mark the rows they write, only those rows are compared
+    with the field of the previous delta
+*/
+typedef struct {
+  int **shadow;         ///< Field as of the previous delta
+  int rows;             ///< Rows of the field
+  int cols;             ///< Columns of the field
+  uint32_t touched;     ///< Rows written since the previous delta
+  GameInfo_t reported;  ///< Numbers as of the previous delta
+  int next;             ///< Next figure as of the previous delta
+  int next_color;       ///< Next color as of the previous delta
+  FrameDelta delta;     ///< Last collected delta
+
+} DeltaTracker;
+
+/*!
+    @brief Initialize the tracker
+    @param tracker Tracker
+    @param rows Rows of the field
+    @param cols Columns of the field
+    @return 0 on success
+
+    The first delta reports every cell and number
+*/
+int DeltaTrackerInit(DeltaTracker *tracker, int rows, int cols);
+
+/*!
+    @brief Release the tracker
+    @param tracker Tracker
+*/
+void DeltaTrackerDestroy(DeltaTracker *tracker);
+
+/*!
+    @brief Copy the tracker into another one of the same size
+    @param dst Initialized tracker
+    @param src Tracker to copy
+*/
+void DeltaTrackerCopy(DeltaTracker *dst, const DeltaTracker *src);
+
+/*!
+    @brief Mark rows as written
+    @param tracker Tracker
+    @param rows Bit i is set if row i was written
+*/
+void DeltaTouchRows(DeltaTracker *tracker, uint32_t rows);
+
+/*!
+    @brief Collect the changes since the previous delta
+    @param tracker Tracker
+    @param info Current game information
+    @return Delta owned by the tracker
+*/
+const FrameDelta *DeltaCollect(DeltaTracker *tracker, const GameInfo_t *info);
+
+#endif
@@ -0,0 +1,401 @@
+/*!
+    @file
+    @brief Memory-mapped binary leaderboard implementation
+*/
+#include "leaderboard.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Magic bytes of the file
+static const char LeaderboardMagic[8] = "BGBOARD";
+
+/*!
+    @brief Create the directory of the file
+    @param path Path to the file
+*/
+static void MakeParent(const char *path) {
+  const char *slash = strrchr(path, '/');
+
+  if (slash == NULL || slash == path) return;
+
+  char dir[256];
+  size_t length = slash - path;
+
+  if (length >= sizeof(dir)) return;
+
+  memcpy(dir, path, length);
+  dir[length] = '\0';
+
+  mkdir(dir, 0777);
+}
+
+/*!
+    @brief Check the layout of the mapped file
+    @param file Mapped file
+    @return 1 if the file can be used
+
+    A file without the magic bytes is a new one, or its creator died
+    before writing the header, so the header is written here
+*/
+static int FileCheck(LeaderboardFile *file) {
+  if (file->magic[0] == '\0') {
+    memset(file, 0, sizeof(*file));
+    memcpy(file->magic, LeaderboardMagic, sizeof(file->magic));
+
+    file->version = LeaderboardVersion;
+    file->tables = LeaderboardGames;
+    file->capacity = LeaderboardSize;
+    file->entry = sizeof(LeaderboardEntry);
+
+    for (int i = 0; i < LeaderboardGames; i++) file->table[i].game = i;
+
+    msync(file, sizeof(*file), MS_SYNC);
+  }
+
+  return memcmp(file->magic, LeaderboardMagic, sizeof(file->magic)) == 0 &&
+         file->version == LeaderboardVersion &&
+         file->tables == LeaderboardGames &&
+         file->capacity == LeaderboardSize &&
+         file->entry == sizeof(LeaderboardEntry);
+}
+
+/*!
+    @brief Open the leaderboard file, creating it if missing
+    @param board Output leaderboard
+    @param path Path to the file
+    @return 0 on success, 1 if the file can not be mapped or has
+            another layout
+
+    The file is created and checked under an exclusive lock, so
+    several processes may open it at once
+*/
+int LeaderboardOpen(Leaderboard *board, const char *path) {
+  board->fd = -1;
+  board->file = NULL;
+
+  MakeParent(path);
+
+  int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+
+  if (fd < 0) return 1;
+
+  struct stat info;
+  void *map = MAP_FAILED;
+  int error = flock(fd, LOCK_EX) || fstat(fd, &info);
+
+  if (!error && info.st_size == 0) {
+    error = ftruncate(fd, sizeof(LeaderboardFile)) != 0;
+    info.st_size = sizeof(LeaderboardFile);
+  }
+
+  if (!error) error = info.st_size != sizeof(LeaderboardFile);
+
+  if (!error) {
+    map = mmap(NULL, sizeof(LeaderboardFile), PROT_READ | PROT_WRITE,
+               MAP_SHARED, fd, 0);
+    error = map == MAP_FAILED || !FileCheck(map);
+  }
+
+  flock(fd, LOCK_UN);
+
+  if (error) {
+    if (map != MAP_FAILED) munmap(map, sizeof(LeaderboardFile));
+    close(fd);
+    return 1;
+  }
+
+  board->fd = fd;
+  board->file = map;
+
+  return 0;
+}
+
+/*!
+    @brief Close the leaderboard
+    @param board Leaderboard
+*/
+void LeaderboardClose(Leaderboard *board) {
+  if (board->file != NULL) munmap(board->file, sizeof(LeaderboardFile));
+  if (board->fd >= 0) close(board->fd);
+
+  board->fd = -1;
+  board->file = NULL;
+}
+
+/*!
+    @brief Get the table of the game
+    @param board Leaderboard
+    @param game Game
+    @return Table inside the mapping, valid until the board is closed
+*/
+const LeaderboardTable *LeaderboardTableOf(const Leaderboard *board,
+                                           LeaderboardGame game) {
+  return &board->file->table[game];
+}
+
+/*!
+    @brief Copy a whole table of the game
+    @param board Leaderboard
+    @param game Game
+    @param copy Output table
+    @return 0 on success, 1 if the file can not be locked
+
+    The table is copied again while a writer changes it, after
+    LeaderboardReadTries copies it is copied under the file lock
+*/
+int LeaderboardRead(const Leaderboard *board, LeaderboardGame game,
+                    LeaderboardTable *copy) {
+  const LeaderboardTable *table = &board->file->table[game];
+  _Atomic uint32_t *sequence = (_Atomic uint32_t *)&table->sequence;
+
+  for (int i = 0; i < LeaderboardReadTries; i++) {
+    uint32_t before = atomic_load_explicit(sequence, memory_order_acquire);
+
+    if (before % 2 == 0) {
+      memcpy(copy, table, sizeof(*copy));
+      atomic_thread_fence(memory_order_acquire);
+
+      if (atomic_load_explicit(sequence, memory_order_relaxed) == before)
+        return 0;
+    }
+
+    sched_yield();
+  }
+
+  if (flock(board->fd, LOCK_SH)) return 1;
+
+  memcpy(copy, table, sizeof(*copy));
+  flock(board->fd, LOCK_UN);
+
+  return 0;
+}
+
+/*!
+    @brief Compare an entry of the table with a name and a rank
+    @param table Table
+    @param rank Rank of the entry
+    @param name Name
+    @param other Rank to compare with
+    @return Negative, zero or positive as the entry goes before, at or
+            after the pair in the name index
+*/
+static int NameCompare(const LeaderboardTable *table, int rank,
+                       const char *name, int other) {
+  int order = strncmp(table->entries[rank].name, name, LeaderboardNameSize);
+
+  return order ? order : rank - other;
+}
+
+/*!
+    @brief Put the inserted entry into the name index
+    @param table Table with the entry in place
+    @param count Number of the entries before the insert
+    @param kept Number of the old entries left in the table
+    @param rank Rank of the inserted entry
+
+    The entry that fell off the table leaves the index, the ranks
+    below the inserted one move down by one
+*/
+static void IndexInsert(LeaderboardTable *table, int count, int kept,
+                        int rank) {
+  const char *name = table->entries[rank].name;
+  int size = 0, at = 0;
+
+  for (int i = 0; i < count; i++) {
+    int other = table->byName[i];
+
+    if (other >= kept) continue;
+    if (other >= rank) other++;
+
+    table->byName[size++] = (uint8_t)other;
+  }
+
+  for (int high = size; at < high;) {
+    int middle = (at + high) / 2;
+
+    if (NameCompare(table, table->byName[middle], name, rank) < 0)
+      at = middle + 1;
+    else
+      high = middle;
+  }
+
+  memmove(&table->byName[at + 1], &table->byName[at], size - at);
+  table->byName[at] = (uint8_t)rank;
+}
+
+/*!
+    @brief Write the pages of the table to the file
+    @param table Table inside the mapping
+
+    The mapping starts at a page, so the first page of the table is
+    inside it
+*/
+static void TableSync(const LeaderboardTable *table) {
+  uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+  uintptr_t start = (uintptr_t)table & ~(page - 1);
+
+  msync((void *)start, (uintptr_t)(table + 1) - start, MS_SYNC);
+}
+
+/*!
+    @brief Insert the entry into the table of the game
+    @param board Leaderboard
+    @param game Game
+    @param entry Entry
+    @return Rank of the entry counted from 0, -1 if it did not make it
+
+    The rank is found by a binary search, an entry goes below the
+    entries with the same score, the entries below it are shifted
+    down in place and the last one falls off a full table. Only the
+    pages of the changed table are written to the file
+*/
+int LeaderboardInsert(Leaderboard *board, LeaderboardGame game,
+                      const LeaderboardEntry *entry) {
+  LeaderboardTable *table = &board->file->table[game];
+  _Atomic uint32_t *sequence = (_Atomic uint32_t *)&table->sequence;
+
+  if (flock(board->fd, LOCK_EX)) return -1;
+
+  int count = table->count < LeaderboardSize ? (int)table->count
+                                             : LeaderboardSize;
+  int low = 0, high = count;
+
+  while (low < high) {
+    int middle = (low + high) / 2;
+
+    if (table->entries[middle].score >= entry->score)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  int rank = low < LeaderboardSize ? low : -1;
+
+  if (rank >= 0) {
+    int kept = count < LeaderboardSize ? count : LeaderboardSize - 1;
+
+    atomic_fetch_add_explicit(sequence, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memmove(&table->entries[rank + 1], &table->entries[rank],
+            (kept - rank) * sizeof(LeaderboardEntry));
+
+    table->entries[rank] = *entry;
+    table->entries[rank].name[LeaderboardNameSize - 1] = '\0';
+    table->count = kept + 1;
+
+    IndexInsert(table, count, kept, rank);
+
+    atomic_fetch_add_explicit(sequence, 1, memory_order_release);
+
+    TableSync(table);
+  }
+
+  flock(board->fd, LOCK_UN);
+
+  return rank;
+}
+
+/*!
+    @brief Find the next entry of the player
+    @param table Table
+    @param name Player name
+    @param from Rank to start from
+    @return Rank of the entry, -1 if there is none
+
+    The table should not change during the call, a table of the
+    mapping is copied with LeaderboardRead first. The entry is found
+    by a binary search of the name index
+*/
+int LeaderboardFind(const LeaderboardTable *table, const char *name, int from) {
+  int count = table->count < LeaderboardSize ? (int)table->count
+                                             : LeaderboardSize;
+  int low = 0, high = count;
+
+  if (from < 0) from = 0;
+
+  while (low < high) {
+    int middle = (low + high) / 2;
+
+    if (NameCompare(table, table->byName[middle], name, from) < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  if (low == count) return -1;
+
+  int rank = table->byName[low];
+
+  return strncmp(table->entries[rank].name, name, LeaderboardNameSize) == 0
+             ? rank
+             : -1;
+}
+
+/*!
+    @brief Fill the entry of a game that ends now
+    @param entry Output entry
+    @param score Score
+    @param level Level reached
+    @param lines Cleared lines
+    @param duration Duration in milliseconds
+
+    The player is the USER of the session
+*/
+void LeaderboardEntryInit(LeaderboardEntry *entry, int score, int level,
+                          int lines, uint32_t duration) {
+  const char *name = getenv("USER");
+
+  memset(entry, 0, sizeof(*entry));
+  snprintf(entry->name, sizeof(entry->name), "%s",
+           name && *name ? name : "Player");
+
+  entry->score = score;
+  entry->level = level;
+  entry->lines = lines;
+  entry->duration = duration;
+  entry->timestamp = time(NULL);
+}
+
+/*!
+    @brief Get the monotonic time used for durations
+    @return Milliseconds
+*/
+uint64_t LeaderboardNow(void) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * 1000u + now.tv_nsec / 1000000;
+}
+
+/*!
+    @brief Open the file, insert the entry and close it
+    @param path Path to the file
+    @param game Game
+    @param entry Entry
+    @return Rank of the entry counted from 0, -1 if it did not make it
+            or the file can not be opened
+*/
+int LeaderboardRecord(const char *path, LeaderboardGame game,
+                      const LeaderboardEntry *entry) {
+  Leaderboard board;
+
+  if (LeaderboardOpen(&board, path)) return -1;
+
+  int rank = LeaderboardInsert(&board, game, entry);
+
+  LeaderboardClose(&board);
+
+  return rank;
+}
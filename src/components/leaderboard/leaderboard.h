@@ -0,0 +1,165 @@
+/*!
+    @file
+    @brief Memory-mapped binary leaderboard
+*/
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdint.h>
+
+/// Leaderboard limits
+typedef enum {
+
+  LeaderboardSize = 100,     ///< Entries kept by every table
+  LeaderboardNameSize = 16,  ///< Bytes of a player name, with the '\0'
+  LeaderboardVersion = 2,    ///< Version of the file layout
+  LeaderboardReadTries = 64  ///< Lock-free reads before a locked one
+
+} LeaderboardLimits;
+
+/// Table of a game
+typedef enum {
+
+  LeaderboardTetris = 0,  ///< Tetris
+  LeaderboardSnake,       ///< Snake
+  LeaderboardGames        ///< Number of the tables
+
+} LeaderboardGame;
+
+/// Finished game, 40 bytes in the file
+typedef struct {
+  char name[LeaderboardNameSize];  ///< Player name
+  int32_t score;                   ///< Score
+  int32_t level;                   ///< Level reached
+  int32_t lines;                   ///< Cleared lines, 0 for Snake
+  uint32_t duration;               ///< Duration in milliseconds
+  int64_t timestamp;               ///< End of the game in Unix seconds
+
+} LeaderboardEntry;
+
+/*!
+    @brief Entries of a game, best score first
+
+    The sequence is odd while a writer changes the table, so a reader
+    of the mapping can check that it saw a whole table. The name index
+    holds the ranks ordered by the name and then by the rank
+*/
+typedef struct {
+  uint32_t game;                              ///< LeaderboardGame
+  uint32_t count;                             ///< Number of the entries
+  uint32_t sequence;                          ///< Number of the changes, x2
+  uint32_t reserved;                          ///< Padding, zero
+  LeaderboardEntry entries[LeaderboardSize];  ///< Entries
+  uint8_t byName[LeaderboardSize];            ///< Ranks sorted by the name
+
+} LeaderboardTable;
+
+/// Layout of the file, in the byte order of the host
+typedef struct {
+  char magic[8];                             ///< "BGBOARD"
+  uint32_t version;                          ///< LeaderboardVersion
+  uint32_t tables;                           ///< LeaderboardGames
+  uint32_t capacity;                         ///< LeaderboardSize
+  uint32_t entry;                            ///< Size of an entry
+  LeaderboardTable table[LeaderboardGames];  ///< Tables of the games
+
+} LeaderboardFile;
+
+/// Opened leaderboard
+typedef struct {
+  int fd;                 ///< Descriptor of the file
+  LeaderboardFile *file;  ///< Shared mapping of the file
+
+} Leaderboard;
+
+/*!
+    @brief Open the leaderboard file, creating it if missing
+    @param board Output leaderboard
+    @param path Path to the file
+    @return 0 on success, 1 if the file can not be mapped or has
+            another layout
+*/
+int LeaderboardOpen(Leaderboard *board, const char *path);
+
+/*!
+    @brief Close the leaderboard
+    @param board Leaderboard
+*/
+void LeaderboardClose(Leaderboard *board);
+
+/*!
+    @brief Get the table of the game
+    @param board Leaderboard
+    @param game Game
+    @return Table inside the mapping, valid until the board is closed
+*/
+const LeaderboardTable *LeaderboardTableOf(const Leaderboard *board,
+                                           LeaderboardGame game);
+
+/*!
+    @brief Copy a whole table of the game
+    @param board Leaderboard
+    @param game Game
+    @param copy Output table
+    @return 0 on success, 1 if the file can not be locked
+
+    The table is copied again while a writer changes it, after
+    LeaderboardReadTries copies it is copied under the file lock
+*/
+int LeaderboardRead(const Leaderboard *board, LeaderboardGame game,
+                    LeaderboardTable *copy);
+
+/*!
+    @brief Insert the entry into the table of the game
+    @param board Leaderboard
+    @param game Game
+    @param entry Entry
+    @return Rank of the entry counted from 0, -1 if it did not make it
+*/
+int LeaderboardInsert(Leaderboard *board, LeaderboardGame game,
+                      const LeaderboardEntry *entry);
+
+/*!
+    @brief Find the next entry of the player
+    @param table Table
+    @param name Player name
+    @param from Rank to start from
+    @return Rank of the entry, -1 if there is none
+
+    The table should not change during the call, a table of the
+    mapping is copied with LeaderboardRead first
+*/
+int LeaderboardFind(const LeaderboardTable *table, const char *name, int from);
+
+/*!
+    @brief Fill the entry of a game that ends now
+    @param entry Output entry
+    @param score Score
+    @param level Level reached
+    @param lines Cleared lines
+    @param duration Duration in milliseconds
+
+    The player is the USER of the session
+*/
+void LeaderboardEntryInit(LeaderboardEntry *entry, int score, int level,
+                          int lines, uint32_t duration);
+
+/*!
+    @brief Get the monotonic time used for durations
+    @return Milliseconds
+*/
+uint64_t LeaderboardNow(void);
+
+/*!
+    @brief Open the file, insert the entry and close it
+    @param path Path to the file
+    @param game Game
+    @param entry Entry
+    @return Rank of the entry counted from 0, -1 if it did not make it
+            or the file can not be opened
+*/
+int LeaderboardRecord(const char *path, LeaderboardGame game,
+                      const LeaderboardEntry *entry);
+
+#endif
@@ -0,0 +1,361 @@
+/*!
+    @file
+    @brief Background persistence of the scores implementation
+*/
+#include "persist.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../scorestore/scorestore.h"
+#include "../trace/trace.h"
+
+/// Kind of a queued save
+typedef enum {
+
+  PersistScore,  ///< High score of ScoreStoreSave
+  PersistEntry,  ///< Leaderboard entry
+  PersistBytes   ///< Bytes appended to the file
+
+} PersistKind;
+
+/// Queued save
+typedef struct {
+  PersistKind kind;              ///< Kind of the save
+  char path[ScoreStorePathMax];  ///< Path to the file
+  int score;                     ///< High score of PersistScore
+  LeaderboardGame game;          ///< Game of PersistEntry
+  LeaderboardEntry entry;        ///< Entry of PersistEntry
+  char *data;                    ///< Bytes of PersistBytes, owned
+  size_t size;                   ///< Number of the bytes
+
+} PersistJob;
+
+/// Saves waiting for the worker, in the order they came
+static PersistJob queue[PersistCapacity];
+
+/// Saves being written, taken from the queue
+static PersistJob batch[PersistCapacity];
+
+/// Number of the waiting saves
+static int queued;
+
+/// The worker is writing a batch
+static int busy;
+
+/// The worker is asked to stop
+static int stopping;
+
+/// The worker is running
+static int started;
+
+/// The stop is registered to run at exit
+static int registered;
+
+/// Worker thread
+static pthread_t worker;
+
+/// Guards the queue and the flags
+static pthread_mutex_t persistMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// Signals the worker about new saves and the stop
+static pthread_cond_t persistWake = PTHREAD_COND_INITIALIZER;
+
+/// Signals the waiters about a taken or written batch
+static pthread_cond_t persistIdle = PTHREAD_COND_INITIALIZER;
+
+/*!
+    @brief Append the bytes of the save to its file
+    @param job Save of PersistBytes, its bytes are released
+*/
+static void WriteBytes(PersistJob *job) {
+  FILE *file = fopen(job->path, "ab");
+
+  if (file != NULL) {
+    fwrite(job->data, 1, job->size, file);
+    fclose(file);
+  }
+
+  free(job->data);
+  job->data = NULL;
+}
+
+/*!
+    @brief Write a batch of saves
+    @param jobs Saves
+    @param count Number of the saves
+
+    Entries of the same leaderboard are inserted through a single
+    mapping of the file
+*/
+static void WriteBatch(PersistJob *jobs, int count) {
+  TraceBegin("PersistBatch");
+
+  for (int i = 0; i < count; i++) {
+    if (jobs[i].kind == PersistScore) {
+      ScoreStoreSave(jobs[i].path, jobs[i].score);
+      continue;
+    }
+
+    if (jobs[i].kind == PersistBytes) {
+      WriteBytes(&jobs[i]);
+      continue;
+    }
+
+    if (jobs[i].path[0] == '\0') continue;
+
+    Leaderboard board;
+    int opened = LeaderboardOpen(&board, jobs[i].path) == 0;
+
+    for (int j = i; j < count; j++) {
+      if (jobs[j].kind != PersistEntry || strcmp(jobs[j].path, jobs[i].path))
+        continue;
+
+      if (opened) LeaderboardInsert(&board, jobs[j].game, &jobs[j].entry);
+
+      if (j > i) jobs[j].path[0] = '\0';
+    }
+
+    if (opened) LeaderboardClose(&board);
+  }
+
+  TraceEnd("PersistBatch");
+}
+
+/*!
+    @brief Take the waiting saves and write them
+
+    Is called with the mutex held, it is released while writing
+*/
+static void WriteQueued(void) {
+  int count = queued;
+
+  memcpy(batch, queue, count * sizeof(PersistJob));
+  queued = 0;
+  busy = 1;
+  pthread_cond_broadcast(&persistIdle);
+
+  pthread_mutex_unlock(&persistMutex);
+
+  WriteBatch(batch, count);
+
+  pthread_mutex_lock(&persistMutex);
+
+  busy = 0;
+  pthread_cond_broadcast(&persistIdle);
+}
+
+/*!
+    @brief Take the waiting saves in batches until stopped
+    @param arg Unused
+    @return NULL
+*/
+static void *WorkerRun(void *arg) {
+  (void)arg;
+
+  pthread_mutex_lock(&persistMutex);
+
+  for (;;) {
+    while (!queued && !stopping)
+      pthread_cond_wait(&persistWake, &persistMutex);
+
+    if (!queued) break;
+
+    WriteQueued();
+  }
+
+  pthread_mutex_unlock(&persistMutex);
+
+  return NULL;
+}
+
+/*!
+    @brief Start the worker if it is not running
+    @return 0 if the worker is running
+
+    Is called with the mutex held
+*/
+static int WorkerStart(void) {
+  if (started) return 0;
+
+  if (pthread_create(&worker, NULL, WorkerRun, NULL)) return 1;
+
+  started = 1;
+
+  if (!registered) registered = atexit(PersistStop) == 0;
+
+  return 0;
+}
+
+/*!
+    @brief Find a waiting high score of the same file
+    @param job Save
+    @return Waiting save, NULL if there is none
+
+    Is called with the mutex held
+*/
+static PersistJob *FindScore(const PersistJob *job) {
+  for (int i = 0; job->kind == PersistScore && i < queued; i++)
+    if (queue[i].kind == PersistScore && strcmp(queue[i].path, job->path) == 0)
+      return &queue[i];
+
+  return NULL;
+}
+
+/*!
+    @brief Queue the save
+    @param job Save
+
+    A waiting high score of the same file takes the larger score
+    instead. A full queue blocks the caller until the worker takes
+    it, so no save is dropped. Without the worker the save is written
+    on the calling thread
+*/
+static void Enqueue(const PersistJob *job) {
+  pthread_mutex_lock(&persistMutex);
+
+  for (;;) {
+    if (WorkerStart()) {
+      pthread_mutex_unlock(&persistMutex);
+
+      PersistJob single = *job;
+
+      WriteBatch(&single, 1);
+
+      return;
+    }
+
+    PersistJob *waiting = FindScore(job);
+
+    if (waiting != NULL) {
+      if (job->score > waiting->score) waiting->score = job->score;
+
+      pthread_mutex_unlock(&persistMutex);
+      return;
+    }
+
+    if (queued < PersistCapacity) break;
+
+    pthread_cond_wait(&persistIdle, &persistMutex);
+  }
+
+  queue[queued++] = *job;
+  pthread_cond_signal(&persistWake);
+
+  pthread_mutex_unlock(&persistMutex);
+}
+
+/*!
+    @brief Queue saving the high score to the file
+    @param path Path to the file
+    @param high_score High score
+    @return 0 if queued, 1 if the path is too long
+
+    A high score still waiting for the same file is replaced by the
+    larger of the two, so repeated saves take a single write. A full
+    queue blocks the caller until the worker takes it
+*/
+int PersistHighScore(const char *path, int high_score) {
+  if (strlen(path) >= ScoreStorePathMax) return 1;
+
+  PersistJob job = {.kind = PersistScore, .score = high_score};
+
+  strcpy(job.path, path);
+  Enqueue(&job);
+
+  return 0;
+}
+
+/*!
+    @brief Queue recording the finished game in the leaderboard
+    @param path Path to the leaderboard file
+    @param game Game
+    @param entry Entry
+    @return 0 if queued, 1 if the path is too long
+
+    A full queue blocks the caller until the worker takes it
+*/
+int PersistRecord(const char *path, LeaderboardGame game,
+                  const LeaderboardEntry *entry) {
+  if (strlen(path) >= ScoreStorePathMax) return 1;
+
+  PersistJob job = {.kind = PersistEntry, .game = game, .entry = *entry};
+
+  strcpy(job.path, path);
+  Enqueue(&job);
+
+  return 0;
+}
+
+/*!
+    @brief Queue appending the bytes to the file
+    @param path Path to the file
+    @param data Bytes, copied by the call
+    @param size Number of the bytes
+    @return 0 if queued, 1 if the path is too long or the bytes can
+            not be copied
+
+    Bytes of the same file are appended in the order they came. A full
+    queue blocks the caller until the worker takes it
+*/
+int PersistAppend(const char *path, const void *data, size_t size) {
+  if (strlen(path) >= ScoreStorePathMax) return 1;
+  if (size == 0) return 0;
+
+  PersistJob job = {.kind = PersistBytes, .data = malloc(size), .size = size};
+
+  if (job.data == NULL) return 1;
+
+  memcpy(job.data, data, size);
+  strcpy(job.path, path);
+  Enqueue(&job);
+
+  return 0;
+}
+
+/*!
+    @brief Wait until the queued saves are written
+*/
+void PersistFlush(void) {
+  pthread_mutex_lock(&persistMutex);
+
+  while (started && (queued || busy))
+    pthread_cond_wait(&persistIdle, &persistMutex);
+
+  pthread_mutex_unlock(&persistMutex);
+}
+
+/*!
+    @brief Write the queued saves and stop the worker
+
+    Also runs at exit, a later save starts the worker again. Saves
+    queued after the worker left its loop are written on the calling
+    thread
+*/
+void PersistStop(void) {
+  pthread_mutex_lock(&persistMutex);
+
+  if (!started || stopping) {
+    pthread_mutex_unlock(&persistMutex);
+    return;
+  }
+
+  stopping = 1;
+  pthread_cond_signal(&persistWake);
+
+  pthread_mutex_unlock(&persistMutex);
+
+  pthread_join(worker, NULL);
+
+  pthread_mutex_lock(&persistMutex);
+
+  while (queued) WriteQueued();
+
+  started = 0;
+  stopping = 0;
+  pthread_cond_broadcast(&persistIdle);
+
+  pthread_mutex_unlock(&persistMutex);
+}
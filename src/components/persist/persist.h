@@ -0,0 +1,71 @@
+/*!
+    @file
+    @brief Background persistence of the scores
+*/
+
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include <stddef.h>
+
+#include "../leaderboard/leaderboard.h"
+
+/// Persistence limits
+typedef enum {
+
+  PersistCapacity = 64  ///< Saves waiting for the worker
+
+} PersistLimits;
+
+/*!
+    @brief Queue saving the high score to the file
+    @param path Path to the file
+    @param high_score High score
+    @return 0 if queued, 1 if the path is too long
+
+    A high score still waiting for the same file is replaced by the
+    larger of the two, so repeated saves take a single write. A full
+    queue blocks the caller until the worker takes it
+*/
+int PersistHighScore(const char *path, int high_score);
+
+/*!
+    @brief Queue recording the finished game in the leaderboard
+    @param path Path to the leaderboard file
+    @param game Game
+    @param entry Entry
+    @return 0 if queued, 1 if the path is too long
+
+    A full queue blocks the caller until the worker takes it
+*/
+int PersistRecord(const char *path, LeaderboardGame game,
+                  const LeaderboardEntry *entry);
+
+/*!
+    @brief Queue appending the bytes to the file
+    @param path Path to the file
+    @param data Bytes, copied by the call
+    @param size Number of the bytes
+    @return 0 if queued, 1 if the path is too long or the bytes can
+            not be copied
+
+    Bytes of the same file are appended in the order they came. A full
+    queue blocks the caller until the worker takes it
+*/
+int PersistAppend(const char *path, const void *data, size_t size);
+
+/*!
+    @brief Wait until the queued saves are written
+*/
+void PersistFlush(void);
+
+/*!
+    @brief Write the queued saves and stop the worker
+
+    Also runs at exit, a later save starts the worker again. Saves
+    queued after the worker left its loop are written on the calling
+    thread
+*/
+void PersistStop(void);
+
+#endif
@@ -0,0 +1,146 @@
+/*!
+    @file
+    @brief Seedable random number generator implementation
+*/
+#include "random.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+/// Number of the entropy seeds taken so far
+static _Atomic uint64_t entropyCalls;
+
+/*!
+    @brief Advance the splitmix64 sequence
+    @param state Sequence state
+    @return Next mixed value
+*/
+static uint64_t SplitMix(uint64_t *state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15u);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+
+  return z ^ (z >> 31);
+}
+
+/*!
+    @brief Rotate the bits to the left
+    @param x Value
+    @param k Bits, between 1 and 31
+*/
+static uint32_t RotateLeft(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+/*!
+    @brief Seed the generator
+    @param rng Generator
+    @param seed Seed, any value
+
+    The state is filled by splitmix64, so close seeds give unrelated
+    sequences
+*/
+void RandomSeed(Random *rng, uint64_t seed) {
+  uint64_t low = SplitMix(&seed), high = SplitMix(&seed);
+
+  rng->state[0] = (uint32_t)low;
+  rng->state[1] = (uint32_t)(low >> 32);
+  rng->state[2] = (uint32_t)high;
+  rng->state[3] = (uint32_t)(high >> 32);
+
+  if (!(low | high)) rng->state[0] = 1;
+}
+
+/*!
+    @brief Get the next number
+    @param rng Generator
+    @return Uniform 32-bit number
+*/
+uint32_t RandomNext(Random *rng) {
+  uint32_t *s = rng->state;
+  uint32_t result = RotateLeft(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = RotateLeft(s[3], 11);
+
+  return result;
+}
+
+/*!
+    @brief Get the next number below the bound
+    @param rng Generator
+    @param bound Bound, greater than 0
+    @return Uniform number in [0, bound)
+
+    Multiplies instead of dividing and rejects the few products
+    that would favour the small numbers
+*/
+int RandomBelow(Random *rng, int bound) {
+  uint32_t range = (uint32_t)bound;
+  uint64_t product = (uint64_t)RandomNext(rng) * range;
+
+  if ((uint32_t)product < range) {
+    uint32_t threshold = -range % range;
+
+    while ((uint32_t)product < threshold)
+      product = (uint64_t)RandomNext(rng) * range;
+  }
+
+  return (int)(product >> 32);
+}
+
+/*!
+    @brief Get a seed that differs between calls and runs
+    @return Seed
+*/
+uint64_t RandomEntropy(void) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_REALTIME, &now);
+
+  uint64_t state =
+      atomic_fetch_add_explicit(&entropyCalls, 1, memory_order_relaxed);
+  uint64_t time = (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+
+  state = SplitMix(&state) ^ time;
+
+  return SplitMix(&state);
+}
+
+/*!
+    @brief Empty the bag, the next draw shuffles a new one
+    @param bag Bag
+*/
+void RandomBagInit(RandomBag *bag) { bag->left = 0; }
+
+/*!
+    @brief Draw the next piece from the bag
+    @param bag Bag
+    @param rng Generator shuffling the bag
+    @return Piece in [0, RandomBagSize)
+
+    Every RandomBagSize draws from a new bag hold every piece once
+*/
+int RandomBagNext(RandomBag *bag, Random *rng) {
+  if (bag->left == 0) {
+    for (int i = 0; i < RandomBagSize; i++) bag->pieces[i] = i;
+
+    for (int i = RandomBagSize - 1; i > 0; i--) {
+      int j = RandomBelow(rng, i + 1);
+      uint8_t piece = bag->pieces[i];
+
+      bag->pieces[i] = bag->pieces[j];
+      bag->pieces[j] = piece;
+    }
+
+    bag->left = RandomBagSize;
+  }
+
+  return bag->pieces[--bag->left];
+}
@@ -0,0 +1,80 @@
+/*!
+    @file
+    @brief Seedable random number generator of a game
+*/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/// Random limits
+typedef enum {
+
+  RandomBagSize = 7  ///< Pieces in a bag, one of every Tetris figure
+
+} RandomLimits;
+
+/*!
+    @brief State of the xoshiro128** generator
+
+    Every game owns one, so games on different threads do not share
+    a state and a seed replays the same sequence
+*/
+typedef struct {
+  uint32_t state[4];  ///< Generator state, never all zero
+
+} Random;
+
+/// Shuffled bag of pieces
+typedef struct {
+  uint8_t pieces[RandomBagSize];  ///< Pieces in the order they are drawn
+  int left;                       ///< Pieces not drawn yet
+
+} RandomBag;
+
+/*!
+    @brief Seed the generator
+    @param rng Generator
+    @param seed Seed, any value
+*/
+void RandomSeed(Random *rng, uint64_t seed);
+
+/*!
+    @brief Get the next number
+    @param rng Generator
+    @return Uniform 32-bit number
+*/
+uint32_t RandomNext(Random *rng);
+
+/*!
+    @brief Get the next number below the bound
+    @param rng Generator
+    @param bound Bound, greater than 0
+    @return Uniform number in [0, bound)
+*/
+int RandomBelow(Random *rng, int bound);
+
+/*!
+    @brief Get a seed that differs between calls and runs
+    @return Seed
+*/
+uint64_t RandomEntropy(void);
+
+/*!
+    @brief Empty the bag, the next draw shuffles a new one
+    @param bag Bag
+*/
+void RandomBagInit(RandomBag *bag);
+
+/*!
+    @brief Draw the next piece from the bag
+    @param bag Bag
+    @param rng Generator shuffling the bag
+    @return Piece in [0, RandomBagSize)
+
+    Every RandomBagSize draws from a new bag hold every piece once
+*/
+int RandomBagNext(RandomBag *bag, Random *rng);
+
+#endif
@@ -0,0 +1,302 @@
+/*!
+    @file
+    @brief Crash-safe store of the high scores implementation
+*/
+#include "scorestore.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// File of the high score shared by all games in earlier versions
+const char ScoreStoreLegacyPath[] = "records/records";
+
+/// Cached score of a file
+typedef struct {
+  char path[ScoreStorePathMax];  ///< Path to the file
+  int score;                     ///< High score
+
+} ScoreSlot;
+
+/// Cached scores
+static ScoreSlot slots[ScoreStoreSlots];
+
+/// Number of cached scores
+static int slotCount;
+
+/// Guards the cache and the writes of this process
+static pthread_mutex_t storeMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+    @brief Find the cached score of the file
+    @param path Path to the file
+    @return Slot, NULL if not cached
+*/
+static ScoreSlot *FindSlot(const char *path) {
+  for (int i = 0; i < slotCount; i++)
+    if (strcmp(slots[i].path, path) == 0) return &slots[i];
+
+  return NULL;
+}
+
+/*!
+    @brief Cache the score of the file
+    @param path Path to the file
+    @param score High score
+
+    Paths that are too long or do not fit are not cached
+*/
+static void CacheScore(const char *path, int score) {
+  ScoreSlot *slot = FindSlot(path);
+
+  if (slot == NULL && slotCount < ScoreStoreSlots &&
+      strlen(path) < ScoreStorePathMax) {
+    slot = &slots[slotCount++];
+    strcpy(slot->path, path);
+  }
+
+  if (slot != NULL) slot->score = score;
+}
+
+/*!
+    @brief Read the high score from the file
+    @param path Path to the file
+    @return High score, 0 if the file is missing or broken
+*/
+static int ReadScore(const char *path) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) return 0;
+
+  char buffer[64] = {0};
+  ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+  int score = 0;
+
+  close(fd);
+
+  if (size <= 0 || sscanf(buffer, "HighScore = %d", &score) < 1) score = 0;
+
+  return score;
+}
+
+/*!
+    @brief Write the whole buffer to the descriptor
+    @param fd File descriptor
+    @param buffer Buffer
+    @param size Size of the buffer
+    @return 0 on success
+*/
+static int WriteAll(int fd, const char *buffer, size_t size) {
+  while (size) {
+    ssize_t written = write(fd, buffer, size);
+
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) return 1;
+
+    buffer += written;
+    size -= written;
+  }
+
+  return 0;
+}
+
+/*!
+    @brief Create the directory of the file
+    @param path Path to the file
+    @param dir Output directory, "." if the path has none
+    @param size Size of dir
+*/
+static void MakeParent(const char *path, char *dir, size_t size) {
+  const char *slash = strrchr(path, '/');
+  size_t length = slash ? (size_t)(slash - path) : 0;
+
+  if (!length || length >= size) {
+    snprintf(dir, size, "%s", slash ? "/" : ".");
+    return;
+  }
+
+  memcpy(dir, path, length);
+  dir[length] = '\0';
+
+  mkdir(dir, 0777);
+}
+
+/*!
+    @brief Take the lock file
+    @param lock Path to the lock file
+    @return Descriptor of the lock file, -1 on error
+
+    The holder removes the lock file when done, so a lock taken on
+    a removed file is dropped and taken again
+*/
+static int LockAcquire(const char *lock) {
+  for (;;) {
+    int fd = open(lock, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+
+    if (fd < 0) return -1;
+
+    if (flock(fd, LOCK_EX)) {
+      close(fd);
+      return -1;
+    }
+
+    struct stat held, current;
+
+    if (fstat(fd, &held) == 0 && stat(lock, &current) == 0 &&
+        held.st_dev == current.st_dev && held.st_ino == current.st_ino)
+      return fd;
+
+    close(fd);
+  }
+}
+
+/*!
+    @brief Release the lock file
+    @param lock Path to the lock file
+    @param fd Descriptor of the lock file
+*/
+static void LockRelease(const char *lock, int fd) {
+  unlink(lock);
+  close(fd);
+}
+
+/*!
+    @brief Replace the file with a synced copy holding the score
+    @param path Path to the file
+    @param tmp Path to the temporary file
+    @param dir Directory of the file
+    @param score High score
+    @return 0 on success
+*/
+static int ReplaceScore(const char *path, const char *tmp, const char *dir,
+                        int score) {
+  char buffer[64];
+  int length = snprintf(buffer, sizeof(buffer), "HighScore = %d", score);
+  int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+  if (fd < 0) return 1;
+
+  int error = WriteAll(fd, buffer, length) || fsync(fd);
+
+  error = close(fd) || error;
+
+  if (!error) error = rename(tmp, path) != 0;
+
+  if (error) {
+    unlink(tmp);
+    return 1;
+  }
+
+  int dirFd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+  if (dirFd >= 0) {
+    fsync(dirFd);
+    close(dirFd);
+  }
+
+  return 0;
+}
+
+/*!
+    @brief Get the high score of the file
+    @param path Path to the file
+    @return High score, 0 if the file is missing or broken
+
+    The file is read once, later calls return the cached score
+*/
+int ScoreStoreLoad(const char *path) {
+  pthread_mutex_lock(&storeMutex);
+
+  ScoreSlot *slot = FindSlot(path);
+  int score = slot ? slot->score : ReadScore(path);
+
+  if (!slot) CacheScore(path, score);
+
+  pthread_mutex_unlock(&storeMutex);
+
+  return score;
+}
+
+/*!
+    @brief Get the high score of the file, taking over an older file
+    @param path Path to the file
+    @param legacy Path to the file the score was kept in before
+    @return High score, 0 if both files are missing or broken
+
+    If path does not exist yet, the score of the legacy file is saved
+    to it first. The legacy file is kept, the games shared it
+*/
+int ScoreStoreMigrate(const char *path, const char *legacy) {
+  pthread_mutex_lock(&storeMutex);
+
+  int missing = FindSlot(path) == NULL && access(path, F_OK) != 0;
+
+  pthread_mutex_unlock(&storeMutex);
+
+  if (missing) {
+    int score = ReadScore(legacy);
+
+    if (score > 0) ScoreStoreSave(path, score);
+  }
+
+  return ScoreStoreLoad(path);
+}
+
+/*!
+    @brief Save the high score to the file
+    @param path Path to the file
+    @param high_score High score
+    @return 0 on success
+
+    Writers of all processes take turns on the lock file path.lock.
+    The file keeps the larger of its score and the new one, it is
+    written to path.tmp, synced and renamed over the old one, so
+    a crash leaves either the old or the new score
+*/
+int ScoreStoreSave(const char *path, int high_score) {
+  char lock[ScoreStorePathMax + 8], tmp[ScoreStorePathMax + 8];
+  char dir[ScoreStorePathMax];
+
+  if (strlen(path) >= ScoreStorePathMax) return 1;
+
+  snprintf(lock, sizeof(lock), "%s.lock", path);
+  snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+  pthread_mutex_lock(&storeMutex);
+
+  MakeParent(path, dir, sizeof(dir));
+
+  int fd = LockAcquire(lock);
+  int error = 1;
+
+  if (fd >= 0) {
+    int stored = ReadScore(path);
+    int score = stored > high_score ? stored : high_score;
+
+    error = score != stored && ReplaceScore(path, tmp, dir, score);
+
+    if (!error) CacheScore(path, score);
+
+    LockRelease(lock, fd);
+  }
+
+  pthread_mutex_unlock(&storeMutex);
+
+  return error;
+}
+
+/*!
+    @brief Drop the cached scores, the next load reads the files again
+*/
+void ScoreStoreForget(void) {
+  pthread_mutex_lock(&storeMutex);
+
+  slotCount = 0;
+
+  pthread_mutex_unlock(&storeMutex);
+}
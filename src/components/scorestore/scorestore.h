@@ -0,0 +1,58 @@
+/*!
+    @file
+    @brief Crash-safe store of the high scores
+*/
+
+#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+/// Score store limits
+typedef enum {
+
+  ScoreStoreSlots = 8,     ///< Files whose score is cached
+  ScoreStorePathMax = 256  ///< Longest cached path
+
+} ScoreStoreLimits;
+
+/// File of the high score shared by all games in earlier versions
+extern const char ScoreStoreLegacyPath[];
+
+/*!
+    @brief Get the high score of the file
+    @param path Path to the file
+    @return High score, 0 if the file is missing or broken
+
+    The file is read once, later calls return the cached score
+*/
+int ScoreStoreLoad(const char *path);
+
+/*!
+    @brief Get the high score of the file, taking over an older file
+    @param path Path to the file
+    @param legacy Path to the file the score was kept in before
+    @return High score, 0 if both files are missing or broken
+
+    If path does not exist yet, the score of the legacy file is saved
+    to it first. The legacy file is kept, the games shared it
+*/
+int ScoreStoreMigrate(const char *path, const char *legacy);
+
+/*!
+    @brief Save the high score to the file
+    @param path Path to the file
+    @param high_score High score
+    @return 0 on success
+
+    Writers of all processes take turns on the lock file path.lock.
+    The file keeps the larger of its score and the new one, it is
+    written to path.tmp, synced and renamed over the old one, so
+    a crash leaves either the old or the new score
+*/
+int ScoreStoreSave(const char *path, int high_score);
+
+/*!
+    @brief Drop the cached scores, the next load reads the files again
+*/
+void ScoreStoreForget(void);
+
+#endif
@@ -0,0 +1,160 @@
+/*!
+    @file
+    @brief Scoped event tracing implementation
+*/
+#include "trace.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/// Ring of the recorded events
+static TraceEvent ring[TraceCapacity];
+
+/// Completion marks of the ring slots
+static _Atomic uint64_t marks[TraceCapacity];
+
+/// Number of recorded events
+static _Atomic uint64_t head;
+
+/// Recording is on
+static _Atomic int enabled;
+
+/// Number of threads that recorded an event
+static _Atomic uint32_t threads;
+
+/// Thread number of the calling thread, 0 until its first event
+static _Thread_local uint32_t thread;
+
+/*!
+    @brief Turn recording on or off
+    @param on Non-zero to record
+*/
+void TraceEnable(int on) {
+  atomic_store_explicit(&enabled, on, memory_order_relaxed);
+}
+
+/*!
+    @brief Check if recording is on
+*/
+int TraceEnabled(void) {
+  return atomic_load_explicit(&enabled, memory_order_relaxed);
+}
+
+/*!
+    @brief Record an event
+    @param name Name of the scope
+    @param phase 'B' on begin, 'E' on end
+
+    The slot is marked as busy while it is written, so a snapshot
+    taken meanwhile skips it
+*/
+static void TraceRecord(const char *name, char phase) {
+  if (!TraceEnabled()) return;
+
+  if (!thread)
+    thread = atomic_fetch_add_explicit(&threads, 1, memory_order_relaxed) + 1;
+
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  uint64_t index = atomic_fetch_add_explicit(&head, 1, memory_order_relaxed);
+  uint64_t slot = index & (TraceCapacity - 1);
+
+  atomic_store_explicit(&marks[slot], 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  ring[slot].name = name;
+  ring[slot].time = (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+  ring[slot].thread = thread;
+  ring[slot].phase = phase;
+
+  atomic_store_explicit(&marks[slot], index + 1, memory_order_release);
+}
+
+/*!
+    @brief Record the begin of a scope
+    @param name Name of the scope, a string literal
+*/
+void TraceBegin(const char *name) { TraceRecord(name, 'B'); }
+
+/*!
+    @brief Record the end of a scope
+    @param name Name of the scope, a string literal
+*/
+void TraceEnd(const char *name) { TraceRecord(name, 'E'); }
+
+/*!
+    @brief Copy the recorded events, oldest first
+    @param events Output array of TraceCapacity events
+    @return Number of copied events
+
+    Events overwritten while copying are skipped
+*/
+int TraceSnapshot(TraceEvent *events) {
+  uint64_t end = atomic_load_explicit(&head, memory_order_acquire);
+  uint64_t begin = end > TraceCapacity ? end - TraceCapacity : 0;
+  int count = 0;
+
+  for (uint64_t index = begin; index < end; index++) {
+    uint64_t slot = index & (TraceCapacity - 1);
+
+    if (atomic_load_explicit(&marks[slot], memory_order_acquire) != index + 1)
+      continue;
+
+    events[count] = ring[slot];
+    atomic_thread_fence(memory_order_acquire);
+
+    if (atomic_load_explicit(&marks[slot], memory_order_relaxed) == index + 1)
+      count++;
+  }
+
+  return count;
+}
+
+/*!
+    @brief Write the recorded events as a Chrome trace JSON file
+    @param path Path to the file
+    @return 0 on success
+
+    Timestamps are microseconds of the monotonic clock
+*/
+int TraceWrite(const char *path) {
+  TraceEvent *events = malloc(TraceCapacity * sizeof(TraceEvent));
+
+  if (events == NULL) return 1;
+
+  mkdir("records", 0777);
+
+  FILE *file = fopen(path, "w");
+
+  if (file == NULL) {
+    free(events);
+    return 1;
+  }
+
+  int count = TraceSnapshot(events);
+
+  fprintf(file, "{\"traceEvents\":[");
+
+  for (int i = 0; i < count; i++)
+    fprintf(file,
+            "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu.%03llu,"
+            "\"pid\":1,\"tid\":%u}",
+            i ? "," : "", events[i].name, events[i].phase,
+            (unsigned long long)(events[i].time / 1000),
+            (unsigned long long)(events[i].time % 1000),
+            (unsigned)events[i].thread);
+
+  fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+  int error = ferror(file);
+
+  fclose(file);
+  free(events);
+
+  return error;
+}
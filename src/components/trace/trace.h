@@ -0,0 +1,104 @@
+/*!
+    @file
+    @brief Scoped event tracing in the Chrome trace format
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/// Trace limits
+typedef enum {
+
+  TraceCapacity = 1 << 16  ///< Events kept by the ring, a power of two
+
+} TraceLimits;
+
+/*!
+    @brief Traced event
+
+    The ring slot is complete when seq is one more than the number
+    of events recorded before it
+*/
+typedef struct {
+  const char *name;  ///< Name of the scope, a string literal
+  uint64_t time;     ///< Monotonic time in nanoseconds
+  uint32_t thread;   ///< Thread number, counted from 1
+  char phase;        ///< 'B' on begin, 'E' on end
+
+} TraceEvent;
+
+/*!
+    @brief Turn recording on or off
+    @param on Non-zero to record
+
+    Recording is off until turned on, so the headless simulator
+    does not pay for it
+*/
+void TraceEnable(int on);
+
+/*!
+    @brief Check if recording is on
+*/
+int TraceEnabled(void);
+
+/*!
+    @brief Record the begin of a scope
+    @param name Name of the scope, a string literal
+*/
+void TraceBegin(const char *name);
+
+/*!
+    @brief Record the end of a scope
+    @param name Name of the scope, a string literal
+*/
+void TraceEnd(const char *name);
+
+/*!
+    @brief Copy the recorded events, oldest first
+    @param events Output array of TraceCapacity events
+    @return Number of copied events
+
+    Events overwritten while copying are skipped
+*/
+int TraceSnapshot(TraceEvent *events);
+
+/*!
+    @brief Write the recorded events as a Chrome trace JSON file
+    @param path Path to the file
+    @return 0 on success
+*/
+int TraceWrite(const char *path);
+
+#ifdef __cplusplus
+extern "C++" {
+namespace s21 {
+
+/**
+ * @brief Trace of the enclosing scope
+ */
+class TraceScope {
+  //! @brief Name of the scope
+  const char *name_;
+
+ public:
+  /**
+   * @brief Record the begin of the scope
+   * @param name Name of the scope, a string literal
+   */
+  explicit TraceScope(const char *name) : name_(name) { TraceBegin(name); }
+
+  /**
+   * @brief Record the end of the scope
+   */
+  ~TraceScope() { TraceEnd(name_); }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+};
+}  // namespace s21
+}
+#endif
+
+#endif
@@ -4,73 +4,151 @@
 */
 #include "CLI.h"
 
+/// Rendered screen behind render()
+static RenderCache renderCache;
+
 /*!
     @brief Console Interface output
     @param gameInfo Game info
     @param code Rendering code
     @return 0 if success
+
+    Static frames are drawn once per terminal size, the field, the next
+    figure and the numbers only where they differ from the last frame
 */
 int render(GameInfo_t *gameInfo, int code) {
-  DeleteStartBanner();
-  DeleteGameOver();
+  RenderCache *cache = &renderCache;
+
+  if (cache->lines != LINES || cache->cols != COLS) {
+    ResetRenderCache();
+    DrawingChrome(gameInfo);
+  }
+
+  int banner = code != cache->code;
 
-  if (gameInfo->field) {
-    DrawingGameFieldBorders((const int **)gameInfo->field);
-    PrintGameField((const int **)gameInfo->field);
+  if (banner) {
+    DeleteStartBanner();
+    DeleteGameOver();
+
+    for (int i = 0; i < FieldRows; i++)
+      for (int j = 0; j < FieldCols; j++) cache->field[i][j] = -1;
+
+    cache->code = code;
   }
 
+  if (gameInfo->field && PrintGameField((const int **)gameInfo->field, cache))
+    banner = 1;
+
   if (code == 1 || code == 2 || code == 3) {
     if (code == 3) {
       DrawingWinBanner();
       refresh();
       napms(1500);
       endwin();
+      ResetRenderCache();
       return 0;
     }
 
-    if (code == 2) DrawingGameOver();
+    if (banner) {
+      if (code == 2) DrawingGameOver();
 
-    DrawingStartBanner();
+      DrawingStartBanner();
+    }
   }
 
-  if (gameInfo->pause)
-    DrawPause();
-  else
-    DeletePause();
+  if (gameInfo->pause != cache->pause) {
+    if (gameInfo->pause)
+      DrawPause();
+    else
+      DeletePause();
 
-  if (gameInfo->next) {
-    DrawingNextFigureField();
-    DrawingNextFigure((const int **)gameInfo->next);
+    cache->pause = gameInfo->pause;
   }
 
-  if (gameInfo->high_score != -1) DrawingHighScore(gameInfo->high_score);
+  if (gameInfo->next) DrawingNextFigure((const int **)gameInfo->next, cache);
+
+  if (gameInfo->high_score != -1 && gameInfo->high_score != cache->high_score) {
+    DrawingHighScore(gameInfo->high_score, &cache->widths[0]);
+    cache->high_score = gameInfo->high_score;
+  }
 
-  if (gameInfo->score != -1) DrawingScore(gameInfo->score);
+  if (gameInfo->score != -1 && gameInfo->score != cache->score) {
+    DrawingScore(gameInfo->score, &cache->widths[1]);
+    cache->score = gameInfo->score;
+  }
 
-  if (gameInfo->level != -1) DrawingLevel(gameInfo->level);
+  if (gameInfo->level != -1 && gameInfo->level != cache->level) {
+    DrawingLevel(gameInfo->level, &cache->widths[2]);
+    cache->level = gameInfo->level;
+  }
 
-  // if(gameInfo.next)
-  //   DrawingNextFigure(gameInfo.next[0][4], gameInfo.next[0][5]);
   return 1;
 }
 
 /*!
-    @brief Print game field
+    @brief Forget the rendered screen, the next render draws everything
+*/
+void ResetRenderCache() {
+  RenderCache *cache = &renderCache;
+
+  for (int i = 0; i < FieldRows; i++)
+    for (int j = 0; j < FieldCols; j++) cache->field[i][j] = -1;
+
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 4; j++) cache->next[i][j] = -1;
+
+  for (int i = 0; i < 3; i++) cache->widths[i] = 0;
+
+  cache->next_color = -1;
+  cache->high_score = -1;
+  cache->score = -1;
+  cache->level = -1;
+  cache->pause = 0;
+  cache->code = -1;
+  cache->lines = -1;
+  cache->cols = -1;
+}
+
+/*!
+    @brief Drawing static frames and labels
+    @param gameInfo Game info
+*/
+void DrawingChrome(const GameInfo_t *gameInfo) {
+  clear();
+
+  if (gameInfo->field) DrawingGameFieldBorders((const int **)gameInfo->field);
+
+  if (gameInfo->next) DrawingNextFigureField();
+
+  DrawingInfoFrames();
+
+  renderCache.lines = LINES;
+  renderCache.cols = COLS;
+}
+
+/*!
+    @brief Print changed cells of the game field
     @param field Field
+    @param cache Rendered screen
+    @return Number of printed cells
 */
-void PrintGameField(const int **field) {
+int PrintGameField(const int **field, RenderCache *cache) {
   attrset(A_BOLD);
 
   int color = 0;
+  int printed = 0;
   int height = field[0][0] - 1;
   int width = field[1][0] - 1;
 
   wchar_t block = OutputFigureBlock_Uni;
 
-  // for (int i = 0; i < FieldRows; i++)
-  //   for (int j = 1; j < FieldCols - 1 ; j++) {
   for (int i = 0; i < height; i++)
     for (int j = 1; j < width; j++) {
+      if (cache->field[i][j] == field[i][j]) continue;
+
+      cache->field[i][j] = field[i][j];
+      printed++;
+
       color = GetColor(field[i][j]);
 
       attron(COLOR_PAIR(color));
@@ -84,6 +162,8 @@ void PrintGameField(const int **field) {
     }
 
   attroff(A_BOLD);
+
+  return printed;
 }
 
 /*!
@@ -290,68 +370,85 @@ void DrawingNextFigureField() {
 }
 
 /*!
-    @brief Drawing high score
-    @param high_score High score
+    @brief Drawing frames and labels of the game information
 */
-void DrawingHighScore(int high_score) {
+void DrawingInfoFrames() {
   attrset(A_BOLD);
 
   print_rectangle(5, 8, 34, 55);
-
   PrintColorStr(8, 38, "HIGHSCORE", Magenta);
 
-  mvprintw(9, 55, "%d", high_score);
+  print_rectangle(9, 12, 34, 55);
+  PrintColorStr(12, 38, "SCORE", Blue);
+
+  print_rectangle(13, 16, 34, 55);
+  PrintColorStr(16, 38, "LEVEL", Red);
 
   attroff(A_BOLD);
 }
 
 /*!
-    @brief Drawing score
-    @param score Score
+    @brief Print a number over the previous one
+    @param y Y coordinate
+    @param x X coordinate
+    @param value Number
+    @param width Printed width of the previous number
 */
-void DrawingScore(int score) {
-  attrset(A_BOLD);
+void PrintNumber(int y, int x, int value, int *width) {
+  char digits[16];
 
-  mvprintw(13, 53, "%s", "          ");
+  int printed = snprintf(digits, sizeof(digits), "%d", value);
 
-  print_rectangle(9, 12, 34, 55);
+  attrset(A_BOLD);
 
-  PrintColorStr(12, 38, "SCORE", Blue);
-  // mvprintw(12, 38, "%s","SCORE");
+  mvprintw(y, x, "%s", digits);
 
-  mvprintw(13, 55, "%d", score);
+  for (int i = printed; i < *width; i++) addch(' ');
 
   attroff(A_BOLD);
+
+  *width = printed;
 }
 
 /*!
-    @brief Drawing level
-    @param level Level
+    @brief Drawing high score
+    @param high_score High score
+    @param width Printed width of the previous value
 */
-void DrawingLevel(int level) {
-  attrset(A_BOLD);
-
-  mvprintw(17, 55, "%s", "   ");
-
-  print_rectangle(13, 16, 34, 55);
-
-  PrintColorStr(16, 38, "LEVEL", Red);
+void DrawingHighScore(int high_score, int *width) {
+  PrintNumber(9, 55, high_score, width);
+}
 
-  mvprintw(17, 55, "%d", level);
+/*!
+    @brief Drawing score
+    @param score Score
+    @param width Printed width of the previous value
+*/
+void DrawingScore(int score, int *width) { PrintNumber(13, 55, score, width); }
 
-  attroff(A_BOLD);
-}
+/*!
+    @brief Drawing level
+    @param level Level
+    @param width Printed width of the previous value
+*/
+void DrawingLevel(int level, int *width) { PrintNumber(17, 55, level, width); }
 
 /*!
-    @brief Drawing next figure
+    @brief Drawing changed cells of the next figure
     @param next Next figure
-    @param color Color
+    @param cache Rendered screen
 */
-void DrawingNextFigure(const int **field) {
+void DrawingNextFigure(const int **field, RenderCache *cache) {
   int sym = 0;
-  int next = field[0][4];
   int color = field[0][5];
 
+  if (color != cache->next_color) {
+    for (int i = 0; i < 2; i++)
+      for (int j = 0; j < 4; j++) cache->next[i][j] = -1;
+
+    cache->next_color = color;
+  }
+
   attrset(A_BOLD);
   attron(COLOR_PAIR(color));
 
@@ -359,11 +456,12 @@ void DrawingNextFigure(const int **field) {
 
   for (int i = 0; i < 2; i++)
     for (int j = 0; j < 4; j++) {
-      // sym = figures[next * 2 + i][j];
-      // sym = getFigureIndex(next * 2 + i, j);
-
       sym = field[i + 2][j];
 
+      if (cache->next[i][j] == sym) continue;
+
+      cache->next[i][j] = sym;
+
       if (!sym)
         wc = L' ';
       else
@@ -390,6 +488,8 @@ int GetColor(int symbol) {
 void ncursesInit() {
   initscr();
 
+  ResetRenderCache();
+
   InitColors();
 
   cbreak();
@@ -13,6 +13,27 @@
 
 #define MVADDCH(y, x, c) mvaddch(2 + (y), 2 + (x), c)
 
+/*!
+    @brief Last rendered state of the screen
+
+    Only cells and numbers that differ from it are redrawn,
+    -1 marks a value that is not on the screen
+*/
+typedef struct {
+  int field[FieldRows][FieldCols];  ///< Field symbols
+  int next[2][4];                   ///< Next figure cells
+  int next_color;                   ///< Next figure color
+  int high_score;                   ///< High score
+  int score;                        ///< Score
+  int level;                        ///< Level
+  int widths[3];                    ///< Printed widths of the numbers
+  int pause;                        ///< Pause banner is shown
+  int code;                         ///< Rendering code of the banners
+  int lines;                        ///< Terminal height of the chrome
+  int cols;                         ///< Terminal width of the chrome
+
+} RenderCache;
+
 /*!
     @brief Initialize ncurses and colors for ncurses
 */
@@ -23,6 +44,31 @@ void ncursesInit();
 */
 void InitColors();
 
+/*!
+    @brief Forget the rendered screen, the next render draws everything
+*/
+void ResetRenderCache();
+
+/*!
+    @brief Drawing static frames and labels
+    @param gameInfo Game info
+*/
+void DrawingChrome(const GameInfo_t *gameInfo);
+
+/*!
+    @brief Drawing frames and labels of the game information
+*/
+void DrawingInfoFrames();
+
+/*!
+    @brief Print a number over the previous one
+    @param y Y coordinate
+    @param x X coordinate
+    @param value Number
+    @param width Printed width of the previous number
+*/
+void PrintNumber(int y, int x, int value, int *width);
+
 /*!
     @brief Print rectangle
     @param top_y Top coordinate
@@ -35,8 +81,9 @@ void print_rectangle(int top_y, int bottom_y, int left_x, int right_x);
 /*!
     @brief Drawing high score
     @param high_score High score
+    @param width Printed width of the previous value
 */
-void DrawingHighScore(int high_score);
+void DrawingHighScore(int high_score, int *width);
 
 /*!
     @brief Drawing field borders
@@ -89,23 +136,25 @@ void DeletePause();
 void DrawingNextFigureField();
 
 /*!
-    @brief Drawing next figure
+    @brief Drawing changed cells of the next figure
     @param next Next figure
-    @param color Color
+    @param cache Rendered screen
 */
-void DrawingNextFigure(const int **next);
+void DrawingNextFigure(const int **next, RenderCache *cache);
 
 /*!
     @brief Drawing score
     @param score Score
+    @param width Printed width of the previous value
 */
-void DrawingScore(int score);
+void DrawingScore(int score, int *width);
 
 /*!
     @brief Drawing level
     @param level Level
+    @param width Printed width of the previous value
 */
-void DrawingLevel(int level);
+void DrawingLevel(int level, int *width);
 
 /*!
     @brief Print color string
@@ -126,10 +175,12 @@ void PrintColorStr(int x, int y, const char *string, int color);
 void PrintColorWc(int x, int y, wchar_t symbol, int color);
 
 /*!
-    @brief Print game field
+    @brief Print changed cells of the game field
     @param field Field
+    @param cache Rendered screen
+    @return Number of printed cells
 */
-void PrintGameField(const int **field);
+int PrintGameField(const int **field, RenderCache *cache);
 
 /*!
     @brief Get color
@@ -5,16 +5,44 @@
 
 #include "DesktopView.h"
 
+#include <iterator>
+
 namespace s21 {
 
+/**
+ * @brief Default key bindings of the desktop
+ */
+static const KeyBinding DesktopBindings[] = {
+    {Qt::Key_Up, ArrowUp},       {Qt::Key_Down, ArrowDown},
+    {Qt::Key_Left, ArrowLeft},   {Qt::Key_Right, ArrowRight},
+    {Qt::Key_Return, ENTER},     {Qt::Key_Enter, ENTER},
+    {Qt::Key_Q, QUIT},           {Qt::Key_P, PAUSE},
+    {Qt::Key_Space, ACTION},     {Qt::Key_F12, STATS}};
+
+/**
+ * @brief Key names of the desktop
+ */
+static const KeyName DesktopNames[] = {
+    {"Up", Qt::Key_Up},         {"Down", Qt::Key_Down},
+    {"Left", Qt::Key_Left},     {"Right", Qt::Key_Right},
+    {"Enter", Qt::Key_Return},  {"Space", Qt::Key_Space},
+    {"Tab", Qt::Key_Tab},       {"Escape", Qt::Key_Escape},
+    {"Backspace", Qt::Key_Backspace}, {"F12", Qt::Key_F12}};
+
 /**
  * @brief Constructor
  * @param controller_ Controller reference
+ * @param backend Field rendering backend
+ * @details Key bindings are read from KeymapPath if it exists. Key
+ *          latency is appended to LatencyPath on exit and on the Stats key,
+ *          which also writes the trace to TracePath
  */
-DesktopView::DesktopView(Controller &controller)
+DesktopView::DesktopView(Controller &controller, RenderBackend backend)
     : QMainWindow(nullptr),
       wid_(new QWidget()),
       controller_(controller),
+      keymap_(DesktopBindings, std::size(DesktopBindings)),
+      simulation_(controller, keymap_, true),
       timer_(new QTimer()),
       gameLayout_(new QHBoxLayout()),
       infoTable_(new QVBoxLayout()),
@@ -24,6 +52,9 @@ DesktopView::DesktopView(Controller &controller)
       nextView_(new QGraphicsView(nextScene_)),
       gameField_(nullptr),
       nextField_(nullptr),
+      backend_(backend),
+      gamePixmap_(nullptr),
+      nextPixmap_(nullptr),
       Score_(new QLabel()),
       Level_(new QLabel()),
       HighScore_(new QLabel()),
@@ -32,7 +63,14 @@ DesktopView::DesktopView(Controller &controller)
       gameOverBanner_(new QGraphicsTextItem()),
       pauseBanner_(new QGraphicsTextItem()),
       winBanner_(new QGraphicsTextItem()),
-      heightGameField_(0) {
+      heightGameField_(0),
+      widthGameField_(0),
+      painting_(false),
+      quitting_(false) {
+  keymap_.load(KeymapPath, DesktopNames, std::size(DesktopNames), true);
+
+  initPalette();
+
   setStyleSheet("background-color: white;");
 
   setCentralWidget(wid_);
@@ -40,46 +78,88 @@ DesktopView::DesktopView(Controller &controller)
 
   setFocus();
 
-  connect(timer_, &QTimer::timeout, this, &DesktopView::pseudoKeyPressEvent);
+  timer_->setTimerType(Qt::PreciseTimer);
+
+  connect(timer_, &QTimer::timeout, this, &DesktopView::present);
 
   GameInfo_t gameInfo = controller_.updateCurrentState();
   initLayout(gameInfo.field, gameInfo.next);
 
-  pseudoKeyPressEvent();
+  gameView_->viewport()->installEventFilter(this);
+
+  simulation_.start();
+  timer_->start(GameLoop::FrameInterval);
 }
 
 /**
- * @brief Pseudo key press event sender
- * @details This function is used to send fake key press event
- *          to key press event
+ * @brief Render the newest frame of the simulation
  */
-void DesktopView::pseudoKeyPressEvent() {
-  QKeyEvent event(QEvent::KeyPress, -1, Qt::NoModifier, QString());
+void DesktopView::present() {
+  if (!simulation_.running()) {
+    timer_->stop();
+    quit();
+    return;
+  }
+
+  if (!simulation_.update()) return;
+
+  render(simulation_.frame().info(), simulation_.frame().code());
 
-  keyPressEvent(&event);
+  if (simulation_.awaitsRender()) gameView_->viewport()->update();
 }
 
 /**
- * @brief Key press event handler
- * @param event Key event
+ * @brief Event filter of the game field viewport
+ * @param watched Watched object
+ * @param event Event
+ * @return true if the event was handled
+ *
+ * @details A paint of the viewport is delivered right away, so the
+ *          rendered frame can be stamped once it is painted
  */
-void DesktopView::keyPressEvent(QKeyEvent *event) {
-  timer_->stop();
+bool DesktopView::eventFilter(QObject *watched, QEvent *event) {
+  if (watched != gameView_->viewport() || event->type() != QEvent::Paint ||
+      painting_)
+    return QMainWindow::eventFilter(watched, event);
 
-  UserAction_t action = Start;
-  bool hold = false;
+  painting_ = true;
+  QCoreApplication::sendEvent(watched, event);
+  painting_ = false;
 
-  controller_.getInput(&action, &hold, event->key());
-  controller_.userInput(action, hold);
+  simulation_.rendered();
 
-  if (action == UserAction_t::Terminate) quit();
+  return true;
+}
 
-  GameInfo_t gameInfo = controller_.updateCurrentState();
+/**
+ * @brief Key press event handler
+ * @param event Key event
+ * @details The key is passed to the simulation thread, the frame
+ *          is rendered by the timer
+ */
+void DesktopView::keyPressEvent(QKeyEvent *event) {
+  if (keymap_.translate(event->key()) == STATS) {
+    if (!event->isAutoRepeat()) {
+      simulation_.latency().save(LatencyPath, "desktop");
+      TraceWrite(TracePath);
+    }
 
-  render(gameInfo, controller_.getStateCode());
+    return;
+  }
 
-  timer_->setInterval(gameInfo.speed);
-  timer_->start();
+  simulation_.push(event->key(), event->isAutoRepeat() ? InputEvent::Repeat
+                                                       : InputEvent::Press);
+}
+
+/**
+ * @brief Key release event handler
+ * @param event Key event
+ * @details Releases repeated by the window system are ignored, the key
+ *          is still held
+ */
+void DesktopView::keyReleaseEvent(QKeyEvent *event) {
+  if (!event->isAutoRepeat())
+    simulation_.push(event->key(), InputEvent::Release);
 }
 
 /**
@@ -106,9 +186,11 @@ void DesktopView::initLayout(int **field, bool next) {
  */
 void DesktopView::createGameField(int height, int width) {
   heightGameField_ = height;
+  widthGameField_ = width;
 
-  newMatrix(gameField_, height, width);
-  initFieldMatrix(gameField_, gameScene_, height, width, 40);
+  createField(gameField_, gameImage_, gamePixmap_, gameScene_, height, width,
+              40);
+  gameCache_.assign(height * width, 0);
 
   startBanner_->setPos(25, 350);
   startBanner_->setHtml(
@@ -148,8 +230,9 @@ void DesktopView::createGameField(int height, int width) {
 void DesktopView::createNextField() {
   int height = 5, width = 6, size = 40;
 
-  newMatrix(nextField_, height, width);
-  initFieldMatrix(nextField_, nextScene_, height, width, size);
+  createField(nextField_, nextImage_, nextPixmap_, nextScene_, height, width,
+              size);
+  nextCache_.assign(2 * 4, 0);
 
   textNext_->setPos(20, 10);
   textNext_->setHtml(
@@ -231,6 +314,52 @@ void DesktopView::hideBanner(QGraphicsTextItem *banner) {
   banner->setVisible(false);
 }
 
+/**
+ * @brief Create field of the chosen backend
+ * @param matrix Matrix
+ * @param image Image
+ * @param pixmap Scene item of the image
+ * @param scene Scene
+ * @param height Height
+ * @param width Width
+ * @param step Step size
+ */
+void DesktopView::createField(QGraphicsRectItem **&matrix, QImage &image,
+                              QGraphicsPixmapItem *&pixmap,
+                              QGraphicsScene *scene, int height, int width,
+                              int step) {
+  if (backend_ == RenderBackend::Image) {
+    initFieldImage(image, pixmap, scene, height, width, step);
+  } else {
+    newMatrix(matrix, height, width);
+    initFieldMatrix(matrix, scene, height, width, step);
+  }
+}
+
+/**
+ * @brief Initialize field image
+ * @param image Image
+ * @param pixmap Scene item of the image
+ * @param scene Scene
+ * @param height Height
+ * @param width Width
+ * @param step Step size
+ * @details The item scales every pixel to a step sized cell
+ *          without smoothing
+ */
+void DesktopView::initFieldImage(QImage &image, QGraphicsPixmapItem *&pixmap,
+                                 QGraphicsScene *scene, int height, int width,
+                                 int step) {
+  image = QImage(width, height, QImage::Format_RGB32);
+  image.fill(pixels_[0]);
+
+  pixmap = new QGraphicsPixmapItem(QPixmap::fromImage(image));
+  pixmap->setTransformationMode(Qt::FastTransformation);
+  pixmap->setScale(step);
+
+  scene->addItem(pixmap);
+}
+
 /**
  * @brief Initialize field matrix
  * @param matrix Matrix
@@ -251,8 +380,8 @@ void DesktopView::initFieldMatrix(QGraphicsRectItem **matrix,
 
       scene->addItem(matrix[i] + j);
 
-      matrix[i][j].setBrush(Qt::white);
-      matrix[i][j].setPen(Qt::NoPen);
+      matrix[i][j].setBrush(brushes_[0]);
+      matrix[i][j].setPen(pens_[0]);
 
       pos_x += step;
 
@@ -303,30 +432,79 @@ QColor DesktopView::getColor(int symbol) {
   return Qt::black;
 }
 
+/**
+ * @brief Build brush and pen palettes
+ */
+void DesktopView::initPalette() {
+  brushes_[0] = QBrush(Qt::white);
+  pens_[0] = QPen(Qt::NoPen);
+
+  for (int i = 1; i < PaletteSize; i++) {
+    brushes_[i] = QBrush(getColor(i - 1));
+    pens_[i] = QPen();
+  }
+
+  for (int i = 0; i < PaletteSize; i++)
+    pixels_[i] = brushes_[i].color().rgb();
+}
+
+/**
+ * @brief Get palette entry of the figure color
+ * @param color Figure color
+ */
+int DesktopView::paletteIndex(int color) {
+  return color >= 0 && color < PaletteSize - 1 ? color + 1 : PaletteSize - 1;
+}
+
+/**
+ * @brief Paint cell if its palette entry changed
+ * @param matrix Field matrix, nullptr for the image backend
+ * @param image Field image
+ * @param row Row of the cell
+ * @param col Column of the cell
+ * @param cached Palette entry last drawn on the cell
+ * @param index New palette entry
+ * @return true if the cell was repainted
+ */
+bool DesktopView::paintCell(QGraphicsRectItem **matrix, QImage &image,
+                            int row, int col, int &cached, int index) {
+  if (cached == index) return false;
+
+  cached = index;
+
+  if (matrix) {
+    matrix[row][col].setBrush(brushes_[index]);
+    matrix[row][col].setPen(pens_[index]);
+  } else {
+    image.setPixel(col, row, pixels_[index]);
+  }
+
+  return true;
+}
+
 /**
  * @brief Update game field matrix
  * @param field Game field
  */
 void DesktopView::updateGameField(int **field) {
-  int color = 0, symbol;
   int height = field[0][0] - 1;
   int width = field[1][0] - 1;
+  bool changed = false;
 
   for (int i = 0; i < height; i++) {
-    for (int j = 1; j < width; j++) {
-      symbol = field[i][j];
+    int *cached = gameCache_.data() + i * widthGameField_;
 
-      color = isFigure(symbol);
+    for (int j = 1; j < width; j++) {
+      int symbol = field[i][j];
+      int index = symbol >= FigureSym ? paletteIndex(isFigure(symbol)) : 0;
 
-      if (symbol >= FigureSym) {
-        gameField_[i][j - 1].setBrush(getColor(color));
-        gameField_[i][j - 1].setPen(QPen());
-      } else {
-        gameField_[i][j - 1].setBrush(Qt::white);
-        gameField_[i][j - 1].setPen(Qt::NoPen);
-      }
+      changed |= paintCell(gameField_, gameImage_, i, j - 1, cached[j - 1],
+                           index);
     }
   }
+
+  if (changed && gamePixmap_)
+    gamePixmap_->setPixmap(QPixmap::fromImage(gameImage_));
 }
 
 /**
@@ -345,20 +523,19 @@ void DesktopView::updateLabelDetails(QLabel *label, const char *base,
  * @param next Next field
  */
 void DesktopView::updateNextField(int **field) {
-  int color = field[0][5];
+  int color = paletteIndex(field[0][5]);
+  bool changed = false;
 
   for (int i = 0, shift = 2; i < 2; i++)
     for (int j = 0; j < 4; j++) {
-      int sym = field[i + 2][j];
-
-      if (!sym) {
-        nextField_[i + shift][j + 1].setBrush(Qt::white);
-        nextField_[i + shift][j + 1].setPen(Qt::NoPen);
-      } else {
-        nextField_[i + shift][j + 1].setBrush(getColor(color));
-        nextField_[i + shift][j + 1].setPen(QPen());
-      }
+      int index = field[i + 2][j] ? color : 0;
+
+      changed |= paintCell(nextField_, nextImage_, i + shift, j + 1,
+                           nextCache_[i * 4 + j], index);
     }
+
+  if (changed && nextPixmap_)
+    nextPixmap_->setPixmap(QPixmap::fromImage(nextImage_));
 }
 
 /**
@@ -368,6 +545,8 @@ void DesktopView::updateNextField(int **field) {
  * @see GameInfo_t
  */
 void DesktopView::render(const GameInfo_t &gameInfo, int code) {
+  TraceScope trace("DesktopView::render");
+
   hideBanner(startBanner_);
   hideBanner(gameOverBanner_);
 
@@ -376,7 +555,10 @@ void DesktopView::render(const GameInfo_t &gameInfo, int code) {
   if (code == 1 || code == 2 || code == 3) {
     if (code == 3) {
       drawBanner(winBanner_);
-      QTimer::singleShot(1500, this, &DesktopView::quit);
+
+      if (!quitting_) QTimer::singleShot(1500, this, &DesktopView::quit);
+
+      quitting_ = true;
       return;
     }
 
@@ -419,12 +601,16 @@ void DesktopView::mousePressEvent(QMouseEvent *event) {
  * @param matrix Matrix
  * @param height Height
  * @param width Width
+ *
+ * @details Items of all rows share one contiguous array
  */
 void DesktopView::newMatrix(QGraphicsRectItem **&matrix, int height,
                             int width) {
+  QGraphicsRectItem *items = new QGraphicsRectItem[height * width];
+
   matrix = new QGraphicsRectItem *[height];
 
-  for (int i = 0; i < height; ++i) matrix[i] = new QGraphicsRectItem[width];
+  for (int i = 0; i < height; ++i) matrix[i] = items + i * width;
 }
 
 /**
@@ -433,8 +619,9 @@ void DesktopView::newMatrix(QGraphicsRectItem **&matrix, int height,
  * @param height Height
  */
 void DesktopView::removeFieldMatrix(QGraphicsRectItem **matrix, int height) {
-  for (int i = 0; i < height; ++i) delete[] matrix[i];
+  Q_UNUSED(height);
 
+  delete[] matrix[0];
   delete[] matrix;
 }
 
@@ -442,13 +629,16 @@ void DesktopView::removeFieldMatrix(QGraphicsRectItem **matrix, int height) {
  * @brief Destructor
  */
 DesktopView::~DesktopView() {
+  simulation_.stop();
+  simulation_.latency().save(LatencyPath, "desktop");
+
   delete HighScore_;
   delete Score_;
   delete Level_;
 
   delete textNext_;
 
-  removeFieldMatrix(gameField_, heightGameField_);
+  if (gameField_) removeFieldMatrix(gameField_, heightGameField_);
 
   if (nextField_) removeFieldMatrix(nextField_, 5);
 
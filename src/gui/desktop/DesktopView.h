@@ -12,14 +12,17 @@
 #include <QtGui>
 #include <QtWidgets>
 #include <iostream>
+#include <vector>
 
 #include "../../components/Controller/Controller.h"
+#include "../../components/GameLoop/SimulationThread.h"
 
 extern "C" {
 #endif
 
 #include "../../brick_game/bg_enums.h"
 #include "../../components/GameInfo/GameInfo.h"
+#include "../../components/trace/trace.h"
 
 #ifdef __cplusplus
 }
@@ -27,6 +30,14 @@ extern "C" {
 
 namespace s21 {
 
+/**
+ * @brief Enumeration of field rendering backends
+ */
+enum class RenderBackend : int {
+  Scene,  ///< One scene item per cell
+  Image   ///< One image pixel per cell, scaled by a single scene item
+};
+
 /**
  * @brief Class for desktop view
  * @details This class is used to display the game on the desktop
@@ -41,7 +52,13 @@ class DesktopView : public QMainWindow {
   //! @brief Controller
   Controller &controller_;
 
-  //! @brief Timer
+  //! @brief Key bindings of the desktop
+  Keymap keymap_;
+
+  //! @brief Game loop running on its own thread
+  SimulationThread simulation_;
+
+  //! @brief Frame timer
   QTimer *timer_;
 
   //! @brief Game layout
@@ -68,6 +85,21 @@ class DesktopView : public QMainWindow {
   //! @brief Next field matrix
   QGraphicsRectItem **nextField_;
 
+  //! @brief Field rendering backend
+  RenderBackend backend_;
+
+  //! @brief Game field image, one pixel per cell
+  QImage gameImage_;
+
+  //! @brief Next field image, one pixel per cell
+  QImage nextImage_;
+
+  //! @brief Scene item showing the game field image
+  QGraphicsPixmapItem *gamePixmap_;
+
+  //! @brief Scene item showing the next field image
+  QGraphicsPixmapItem *nextPixmap_;
+
   //! @brief Score label
   QLabel *Score_;
 
@@ -95,12 +127,57 @@ class DesktopView : public QMainWindow {
   //! @brief Height of the game field matrix
   int heightGameField_;
 
+  //! @brief Width of the game field matrix
+  int widthGameField_;
+
+  //! @brief The viewport paint is being delivered by the event filter
+  bool painting_;
+
+  //! @brief The quit after the win banner is scheduled
+  bool quitting_;
+
+  /**
+   * @brief Number of palette entries
+   * @details Entry 0 is an empty cell, entries 1..8 are figure colors
+   *          and the last one is the fallback black
+   */
+  static constexpr int PaletteSize = 10;
+
+  //! @brief Brushes indexed by palette entry
+  QBrush brushes_[PaletteSize];
+
+  //! @brief Pens indexed by palette entry
+  QPen pens_[PaletteSize];
+
+  //! @brief Image pixels indexed by palette entry
+  QRgb pixels_[PaletteSize];
+
+  //! @brief Palette entries last drawn on the game field
+  std::vector<int> gameCache_;
+
+  //! @brief Palette entries last drawn on the next field
+  std::vector<int> nextCache_;
+
  public:
+  //! @brief Path to the key bindings of the desktop
+  static constexpr const char *KeymapPath = "keymap/desktop";
+
+  //! @brief Path to the key latency report
+  static constexpr const char *LatencyPath = "records/latency";
+
+  //! @brief Path to the Chrome trace
+  static constexpr const char *TracePath = "records/trace.json";
+
   /**
    * @brief Constructor
    * @param controller_ Controller reference
+   * @param backend Field rendering backend
+   * @details Key bindings are read from KeymapPath if it exists. Key
+   *          latency is appended to LatencyPath on exit and on the Stats key,
+   *          which also writes the trace to TracePath
    */
-  DesktopView(Controller &controller);
+  DesktopView(Controller &controller,
+              RenderBackend backend = RenderBackend::Scene);
 
   /**
    * @brief Destructor
@@ -111,15 +188,34 @@ class DesktopView : public QMainWindow {
   /**
    * @brief Key press event handler
    * @param event Key event
+   * @details The key is passed to the simulation thread, the frame
+   *          is rendered by the timer
    */
   void keyPressEvent(QKeyEvent *event) override;
 
   /**
-   * @brief Pseudo key press event sender
-   * @details This function is used to send fake key press event
-   *          to key press event
+   * @brief Key release event handler
+   * @param event Key event
+   * @details Releases repeated by the window system are ignored, the key
+   *          is still held
+   */
+  void keyReleaseEvent(QKeyEvent *event) override;
+
+  /**
+   * @brief Render the newest frame of the simulation
+   */
+  void present();
+
+  /**
+   * @brief Event filter of the game field viewport
+   * @param watched Watched object
+   * @param event Event
+   * @return true if the event was handled
+   *
+   * @details A paint of the viewport is delivered right away, so the
+   *          rendered frame can be stamped once it is painted
    */
-  void pseudoKeyPressEvent();
+  bool eventFilter(QObject *watched, QEvent *event) override;
 
   /**
    * @brief Mouse press event handler
@@ -216,11 +312,65 @@ class DesktopView : public QMainWindow {
    */
   QColor getColor(int symbol);
 
+  /**
+   * @brief Build brush and pen palettes
+   */
+  void initPalette();
+
+  /**
+   * @brief Get palette entry of the figure color
+   * @param color Figure color
+   */
+  int paletteIndex(int color);
+
+  /**
+   * @brief Paint cell if its palette entry changed
+   * @param matrix Field matrix, nullptr for the image backend
+   * @param image Field image
+   * @param row Row of the cell
+   * @param col Column of the cell
+   * @param cached Palette entry last drawn on the cell
+   * @param index New palette entry
+   * @return true if the cell was repainted
+   */
+  bool paintCell(QGraphicsRectItem **matrix, QImage &image, int row, int col,
+                 int &cached, int index);
+
+  /**
+   * @brief Create field of the chosen backend
+   * @param matrix Matrix
+   * @param image Image
+   * @param pixmap Scene item of the image
+   * @param scene Scene
+   * @param height Height
+   * @param width Width
+   * @param step Step size
+   */
+  void createField(QGraphicsRectItem **&matrix, QImage &image,
+                   QGraphicsPixmapItem *&pixmap, QGraphicsScene *scene,
+                   int height, int width, int step);
+
+  /**
+   * @brief Initialize field image
+   * @param image Image
+   * @param pixmap Scene item of the image
+   * @param scene Scene
+   * @param height Height
+   * @param width Width
+   * @param step Step size
+   * @details The item scales every pixel to a step sized cell
+   *          without smoothing
+   */
+  void initFieldImage(QImage &image, QGraphicsPixmapItem *&pixmap,
+                      QGraphicsScene *scene, int height, int width, int step);
+
   /**
    * @brief Create new matrix for field
    * @param matrix Matrix
    * @param height Height
    * @param width Width
+   *
+   * @details Items of all rows share one contiguous array
    */
   void newMatrix(QGraphicsRectItem **&matrix, int height, int width);
 
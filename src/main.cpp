@@ -3,11 +3,133 @@
  * @brief Main file
  */
 
+#include <ctime>
+
 #include "brick_game.h"
 
 using namespace s21;
 
-int main() {
+//! @brief Directory of the recorded games
+static const char *ReplayDir = "records/replays";
+
+/**
+ * @brief Path of a new replay
+ * @return Path named after the local time, the recorder adds a suffix if
+ *         another game took it
+ */
+static std::string replayPath() {
+  std::time_t now = std::time(nullptr);
+  char name[32];
+
+  std::strftime(name, sizeof(name), "replay-%Y%m%d-%H%M%S",
+                std::localtime(&now));
+
+  return std::string(ReplayDir) + "/" + name;
+}
+
+/**
+ * @brief Play a recorded game
+ * @param path Path to the replay
+ * @param headless Play at full speed without a view and report the result
+ * @return Exit code, 1 if the replay can not be read or diverged
+ */
+static int playReplay(const char *path, bool headless) {
+  Replay replay;
+
+  if (!replay.load(path)) {
+    std::cerr << "Can not read the replay " << path << std::endl;
+    return 1;
+  }
+
+  GameFactory factory;
+  Controller controller(factory.createModel(
+      replay.game == ReplayGame::Snake ? GameType::Snake : GameType::Tetris));
+  ReplayPlayer player(controller, replay);
+
+  if (headless) {
+    player.run(replay.steps.size());
+
+    const GameInfo_t &info = player.info();
+
+    std::cout << "Steps: " << player.position() << "/" << replay.steps.size()
+              << std::endl;
+    std::cout << "Time: " << player.time() / 1000.0 << " s" << std::endl;
+    std::cout << "Score: " << info.score << std::endl;
+
+    if (player.diverged() != -1) {
+      std::cout << "Diverged at checkpoint " << player.diverged() << std::endl;
+      return 1;
+    }
+
+    std::cout << "Checkpoints matched: " << replay.checks.size() << std::endl;
+
+    return 0;
+  }
+
+  controller.play(&player);
+
+  IView *view = factory.createView(getViewType(), controller);
+
+  view->startEventLoop();
+
+  delete view;
+
+  PersistStop();
+
+  return 0;
+}
+
+/**
+ * @brief Check if the flag is given
+ * @param argc Number of the arguments
+ * @param argv Arguments
+ * @param flag Flag
+ * @return true if one of the arguments is the flag
+ */
+static bool hasFlag(int argc, char *argv[], const char *flag) {
+  for (int i = 1; i < argc; i++)
+    if (std::string(argv[i]) == flag) return true;
+
+  return false;
+}
+
+/**
+ * @brief Get the value of the option
+ * @param argc Number of the arguments
+ * @param argv Arguments
+ * @param option Option
+ * @return Argument after the option, nullptr if the option is not given
+ */
+static const char *optionValue(int argc, char *argv[], const char *option) {
+  for (int i = 1; i + 1 < argc; i++)
+    if (std::string(argv[i]) == option) return argv[i + 1];
+
+  return nullptr;
+}
+
+/**
+ * @brief Check if tracing is asked for
+ * @param argc Number of the arguments
+ * @param argv Arguments
+ * @return true for --trace or a BRICK_GAME_TRACE other than 0
+ */
+static bool traceRequested(int argc, char *argv[]) {
+  const char *env = std::getenv("BRICK_GAME_TRACE");
+
+  if (hasFlag(argc, argv, "--trace")) return true;
+
+  return env != nullptr && *env && std::string(env) != "0";
+}
+
+int main(int argc, char *argv[]) {
+  TraceEnable(traceRequested(argc, argv));
+
+  const char *verify = optionValue(argc, argv, "--verify");
+  const char *replay = optionValue(argc, argv, "--replay");
+
+  if (verify != nullptr) return playReplay(verify, true);
+  if (replay != nullptr) return playReplay(replay, false);
+
   GameType gameType = getGameType();
   ViewType viewType = getViewType();
 
@@ -16,6 +138,24 @@ int main() {
   IModel *model = factory.createModel(gameType);
 
   Controller controller(model);
+  bool bagged = hasFlag(argc, argv, "--bag");
+
+  controller.loadHighScore();
+
+  // The seed draws the next figure again, from the chosen randomizer
+  controller.setBag(bagged);
+  controller.setSeed(controller.getSeed());
+
+  std::unique_ptr<ReplayRecorder> recorder;
+
+  if (hasFlag(argc, argv, "--record")) {
+    recorder = std::make_unique<ReplayRecorder>(
+        replayPath(),
+        gameType == GameType::Snake ? ReplayGame::Snake : ReplayGame::Tetris,
+        controller.getSeed(), bagged);
+
+    controller.record(recorder.get());
+  }
 
   IView *view = factory.createView(viewType, controller);
 
@@ -23,5 +163,18 @@ int main() {
 
   delete view;
 
+  if (recorder) {
+    std::string path = recorder->path();
+
+    recorder->finish();
+
+    if (path.empty())
+      std::cerr << "Replay: the file could not be created" << std::endl;
+    else
+      std::cout << "Replay: " << path << std::endl;
+  }
+
+  PersistStop();
+
   return 0;
-}
\ No newline at end of file
+}
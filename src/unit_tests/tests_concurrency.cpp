@@ -0,0 +1,132 @@
+#include "tests_entry.h"
+
+struct Payload {
+  int seq;
+  int data[64];
+};
+
+TEST(TripleBufferTest, NewestValue) {
+  // Arrange
+  s21::TripleBuffer<int> buffer;
+
+  // Act
+  bool empty = buffer.update();
+
+  for (int i = 1; i <= 3; i++) {
+    buffer.back() = i;
+    buffer.publish();
+  }
+
+  // Assert
+  EXPECT_FALSE(empty);
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.front(), 3);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.front(), 3);
+}
+
+TEST(TripleBufferTest, NoTearing) {
+  // Arrange
+  s21::TripleBuffer<Payload> buffer;
+  const int frames = 100000;
+  int last = 0, torn = 0;
+
+  // Act
+  std::thread producer([&buffer] {
+    for (int i = 1; i <= frames; i++) {
+      Payload &payload = buffer.back();
+
+      payload.seq = i;
+      for (int &value : payload.data) value = i;
+
+      buffer.publish();
+    }
+  });
+
+  while (last < frames) {
+    if (!buffer.update()) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const Payload &payload = buffer.front();
+
+    for (int value : payload.data) torn += value != payload.seq;
+
+    EXPECT_GT(payload.seq, last);
+    last = payload.seq;
+  }
+
+  producer.join();
+
+  // Assert
+  EXPECT_EQ(torn, 0);
+  EXPECT_EQ(last, frames);
+}
+
+TEST(SpscQueueTest, Order) {
+  // Arrange
+  s21::SpscQueue<int, 8> queue;
+  const int items = 100000;
+  int expected = 0, item = 0, overflow = 0;
+
+  for (int i = 0; i < 8; i++) queue.push(i);
+  overflow = !queue.push(8);
+
+  while (queue.pop(item)) {
+    EXPECT_EQ(item, expected++);
+  }
+
+  // Act
+  std::thread producer([&queue] {
+    for (int i = 0; i < items; i++)
+      while (!queue.push(i)) std::this_thread::yield();
+  });
+
+  for (expected = 0; expected < items;) {
+    if (!queue.pop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    EXPECT_EQ(item, expected++);
+  }
+
+  producer.join();
+
+  // Assert
+  EXPECT_TRUE(overflow);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(FrameTest, OwnsCopy) {
+  // Arrange
+  TetrisContext ctx;
+  TetrisContextInit(&ctx);
+
+  GameInfo_t info = TetrisUpdateCurrentState(&ctx);
+  s21::Frame frame;
+
+  // Act
+  frame.assign(info, 1);
+
+  info.field[3][4] = FigureSym;
+  info.next[0][5] = 6;
+
+  // Assert
+  EXPECT_EQ(frame.code(), 1);
+  EXPECT_NE(frame.info().field, info.field);
+  EXPECT_EQ(frame.info().field[0][0], FieldRows);
+  EXPECT_EQ(frame.info().field[1][0], FieldCols);
+  EXPECT_EQ(frame.info().field[3][4], ' ');
+  EXPECT_NE(frame.info().next, info.next);
+  EXPECT_EQ(frame.info().score, info.score);
+
+  info.next = nullptr;
+  frame.assign(info, 0);
+
+  EXPECT_EQ(frame.info().next, nullptr);
+  EXPECT_EQ(frame.info().field[3][4], FigureSym);
+
+  TetrisContextDestroy(&ctx);
+}
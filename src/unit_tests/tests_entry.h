@@ -8,14 +8,129 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
+#include "../brick_game/env/inc/vectorEnv.h"
 #include "../brick_game/snake/inc/snakeModel.h"
+#include "../components/Concurrency/SpscQueue.h"
+#include "../components/Concurrency/TripleBuffer.h"
+#include "../components/GameLoop/Frame.h"
+#include "../components/GameLoop/GameLoop.h"
+#include "../components/GameLoop/SimulationThread.h"
+#include "../components/Input/InputQueue.h"
+#include "../components/Input/Keymap.h"
+#include "../components/Profiling/Latency.h"
+#include "../components/Replay/Replay.h"
+#include "../components/Wrappers/Tetris/TetrisModel.h"
 
 extern "C" {
 #endif
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../brick_game/tetris/inc/simulator.h"
+#include "../components/leaderboard/leaderboard.h"
+#include "../components/persist/persist.h"
+#include "../components/random/random.h"
+#include "../components/scorestore/scorestore.h"
+#include "../components/trace/trace.h"
+
 #ifdef __cplusplus
 }
+
+/**
+ * @brief Test in a directory of its own
+ * @details The records a test saves are removed with the directory, so
+ *          no test reads the records of another test or of an earlier run
+ */
+class RecordsTest : public ::testing::Test {
+ protected:
+  std::filesystem::path home;
+  std::filesystem::path directory;
+
+  void SetUp() override {
+    home = std::filesystem::current_path();
+    directory = std::filesystem::temp_directory_path() /
+                ("brick_game_test_" + std::to_string(getpid()));
+
+    PersistFlush();
+    ScoreStoreForget();
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::current_path(directory);
+  }
+
+  void TearDown() override {
+    PersistFlush();
+    ScoreStoreForget();
+    std::filesystem::current_path(home);
+    std::filesystem::remove_all(directory);
+  }
+};
+
+/**
+ * @brief Action and key fed to a model
+ */
+struct WalkStep {
+  UserAction_t action;
+  int key;
+};
+
+/**
+ * @brief Random walk through the actions of a game
+ * @details A game that is not running is started again, so a long walk
+ *          plays many games
+ */
+class RandomWalk {
+ public:
+  RandomWalk(s21::ReplayGame game, uint64_t seed) : game_(game) {
+    RandomSeed(&random_, seed);
+  }
+
+  /**
+   * @brief Next step of the walk
+   * @param state State of the game before the step
+   */
+  WalkStep next(State state) {
+    static const WalkStep snake[] = {
+        {Start, -1}, {Up, ArrowUp},     {Start, -1},        {Left, ArrowLeft},
+        {Start, -1}, {Down, ArrowDown}, {Right, ArrowRight}};
+    static const WalkStep tetris[] = {
+        {Start, -1},         {Left, ArrowLeft}, {Action, ACTION},
+        {Right, ArrowRight}, {Down, ArrowDown}, {Start, -1}};
+    bool isSnake = game_ == s21::ReplayGame::Snake;
+    WalkStep step = isSnake ? snake[RandomBelow(&random_, 7)]
+                            : tetris[RandomBelow(&random_, 6)];
+
+    if (state == Launch || state == GameOver || state == Win)
+      step = {Start, ENTER};
+
+    return step;
+  }
+
+  /**
+   * @brief Feed the next step of the walk to the model
+   * @param model Model of the game of the walk
+   */
+  void step(s21::IModel &model) { feed(model, next(model.getState())); }
+
+  /**
+   * @brief Feed a step to the model
+   * @param model Model
+   * @param step Step of a walk
+   */
+  static void feed(s21::IModel &model, const WalkStep &step) {
+    model.setKey(step.key);
+    model.userInput(step.action, false);
+  }
+
+ private:
+  s21::ReplayGame game_;
+  Random random_;
+};
 #endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "tests_entry.h"
+
+using std::chrono::milliseconds;
+
+static const int TickSpeed = 100;
+
+/**
+ * @brief Model counting its ticks and keys
+ * @details The score grows by 10 every third tick. Like the games, the
+ *          model reports the score and the level only when they changed
+ *          and -1 otherwise
+ */
+class TickModel : public s21::IModel {
+ public:
+  int ticks = 0;
+  int keys = 0;
+
+  void userInput(UserAction_t, bool) override {
+    if (key_ != -1) {
+      keys++;
+      return;
+    }
+
+    if (++ticks % 3 == 0) {
+      score_ += 10;
+      scored_ = true;
+    }
+  }
+
+  GameInfo_t updateCurrentState() override {
+    GameInfo_t info = {nullptr, nullptr, -1, -1, -1, TickSpeed, 0};
+
+    if (scored_) info.score = score_;
+    if (first_) info.score = info.high_score = info.level = 0;
+
+    scored_ = first_ = false;
+
+    return info;
+  }
+
+  const FrameDelta &updateFrameDelta() override { return delta_; }
+  void setKey(int key) override { key_ = key; }
+  int getLastKey() override { return key_; }
+  State getState() override { return Moving; }
+  void setSeed(uint64_t) override {}
+  uint64_t getSeed() override { return 0; }
+  void setBag(bool) override {}
+  std::unique_ptr<IModel> snapshot() override {
+    return std::make_unique<TickModel>(*this);
+  }
+  void restore(const IModel &) override {}
+  void setRecords(const char *) override {}
+  void setPersistent(bool) override {}
+  void loadHighScore() override {}
+
+ private:
+  int key_ = -1;
+  int score_ = 0;
+  bool scored_ = false;
+  bool first_ = true;
+  FrameDelta delta_ = {};
+};
+
+static s21::GameLoop::Clock::time_point at(int ms) {
+  return s21::GameLoop::Clock::time_point(milliseconds(ms));
+}
+
+TEST(GameLoopTest, CatchUpIsCapped) {
+  // Arrange
+  TickModel *model = new TickModel();
+  s21::Controller controller(model);
+  s21::GameLoop loop(controller, at(0));
+
+  // Act
+  int early = loop.advance(at(TickSpeed - 1));
+  int due = loop.advance(at(TickSpeed));
+  int stalled = loop.advance(at(20 * TickSpeed));
+  int resumed = loop.advance(at(21 * TickSpeed - 1));
+  int next = loop.advance(at(21 * TickSpeed));
+
+  // Assert
+  EXPECT_EQ(early, 0);
+  EXPECT_EQ(due, 1);
+  EXPECT_EQ(stalled, s21::GameLoop::MaxCatchUp);
+  EXPECT_EQ(resumed, 0);
+  EXPECT_EQ(next, 1);
+  EXPECT_EQ(model->ticks, 2 + s21::GameLoop::MaxCatchUp);
+}
+
+TEST(GameLoopTest, KeysKeepTheSchedule) {
+  // Arrange
+  TickModel *model = new TickModel();
+  s21::Controller controller(model);
+  s21::GameLoop loop(controller, at(0));
+
+  loop.advance(at(TickSpeed / 2));
+
+  // Act
+  for (int i = 0; i < 10; i++) loop.input(ArrowLeft, false);
+
+  loop.frame(at(TickSpeed / 2));
+
+  int delay = loop.delay(at(TickSpeed / 2));
+  int before = loop.advance(at(TickSpeed - 1));
+  int due = loop.advance(at(TickSpeed));
+  bool terminated = !loop.input(QUIT, false);
+
+  // Assert
+  EXPECT_EQ(model->keys, 11);
+  EXPECT_EQ(delay, TickSpeed / 2);
+  EXPECT_EQ(before, 0);
+  EXPECT_EQ(due, 1);
+  EXPECT_TRUE(terminated);
+}
+
+TEST(GameLoopTest, MergesBatchedSteps) {
+  // Arrange
+  TickModel *model = new TickModel();
+  s21::Controller controller(model);
+  s21::GameLoop loop(controller, at(0));
+
+  GameInfo_t start = loop.frame(at(0));
+
+  // Act
+  bool early = loop.frameDue(at(s21::GameLoop::FrameInterval));
+
+  int ticks = loop.advance(at(5 * TickSpeed));
+  bool throttled = loop.frameDue(at(s21::GameLoop::FrameInterval - 1));
+  bool due = loop.frameDue(at(5 * TickSpeed));
+  GameInfo_t merged = loop.frame(at(5 * TickSpeed));
+
+  loop.advance(at(6 * TickSpeed));
+
+  GameInfo_t scored = loop.frame(at(6 * TickSpeed));
+
+  loop.advance(at(7 * TickSpeed));
+
+  GameInfo_t unchanged = loop.frame(at(7 * TickSpeed));
+
+  // Assert
+  EXPECT_EQ(start.score, 0);
+  EXPECT_EQ(start.level, 0);
+  EXPECT_FALSE(early);
+  EXPECT_EQ(ticks, 5);
+  EXPECT_FALSE(throttled);
+  EXPECT_TRUE(due);
+  EXPECT_EQ(merged.score, 10);
+  EXPECT_EQ(merged.level, -1);
+  EXPECT_EQ(scored.score, 20);
+  EXPECT_EQ(unchanged.score, -1);
+}
+
+TEST(SimulationThreadTest, PublishesAndTerminates) {
+  // Arrange
+  const s21::KeyBinding bindings[] = {{'q', QUIT}};
+  s21::Keymap keymap(bindings, 1);
+  s21::Controller controller(new TickModel());
+  s21::SimulationThread thread(controller, keymap, false);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  bool published = false;
+
+  // Act
+  thread.start();
+
+  while (!published && std::chrono::steady_clock::now() < deadline) {
+    published = thread.update();
+    std::this_thread::sleep_for(milliseconds(1));
+  }
+
+  thread.push('q');
+
+  while (thread.running() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(milliseconds(1));
+
+  thread.stop();
+
+  // Assert
+  EXPECT_TRUE(published);
+  EXPECT_FALSE(thread.running());
+}
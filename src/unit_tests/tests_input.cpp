@@ -0,0 +1,161 @@
+#include "tests_entry.h"
+
+using std::chrono::milliseconds;
+
+static const int ShiftKey = 1, OtherKey = 2;
+
+static bool isShiftKey(int key) { return key == ShiftKey; }
+
+static s21::InputQueue::Clock::time_point at(int ms) {
+  return s21::InputQueue::Clock::time_point(milliseconds(ms));
+}
+
+static std::vector<s21::KeyInput> pollAll(s21::InputQueue &queue, int ms) {
+  std::vector<s21::KeyInput> inputs;
+  s21::KeyInput input;
+
+  while (queue.poll(at(ms), input)) inputs.push_back(input);
+
+  return inputs;
+}
+
+TEST(InputQueueTest, TerminalRepeatsCoalesce) {
+  // Arrange
+  s21::InputQueue queue(isShiftKey, false);
+
+  queue.push({ShiftKey, s21::InputEvent::Press, at(0)});
+  for (int ms = 500; ms <= 800; ms += 20)
+    queue.push({ShiftKey, s21::InputEvent::Press, at(ms)});
+
+  // Act
+  std::vector<s21::KeyInput> inputs = pollAll(queue, 2000);
+
+  // Assert
+  ASSERT_EQ(inputs.size(), 10u);
+  EXPECT_FALSE(inputs[0].hold);
+  EXPECT_EQ(inputs[0].time, at(0));
+  EXPECT_FALSE(inputs[1].hold);
+  EXPECT_EQ(inputs[1].time, at(500));
+  EXPECT_FALSE(inputs[2].hold);
+  EXPECT_EQ(inputs[2].time, at(520));
+  for (std::size_t i = 3; i < inputs.size(); i++) {
+    EXPECT_TRUE(inputs[i].hold);
+    EXPECT_EQ(inputs[i].time, at(520) + (i - 2) * milliseconds(50));
+  }
+  EXPECT_EQ(queue.deadline(), s21::InputQueue::Clock::time_point::max());
+}
+
+TEST(InputQueueTest, TerminalDoubleTap) {
+  // Arrange
+  s21::InputQueue queue(isShiftKey, false);
+  s21::InputQueue tripled(isShiftKey, false);
+
+  queue.push({ShiftKey, s21::InputEvent::Press, at(0)});
+  queue.push({ShiftKey, s21::InputEvent::Press, at(90)});
+
+  for (int ms = 0; ms <= 60; ms += 30)
+    tripled.push({ShiftKey, s21::InputEvent::Press, at(ms)});
+
+  // Act
+  std::vector<s21::KeyInput> inputs = pollAll(queue, 1000);
+  std::vector<s21::KeyInput> repeated = pollAll(tripled, 1000);
+
+  // Assert
+  ASSERT_EQ(inputs.size(), 2u);
+  EXPECT_EQ(inputs[0].time, at(0));
+  EXPECT_EQ(inputs[1].time, at(90));
+  for (const s21::KeyInput &input : inputs) EXPECT_FALSE(input.hold);
+  ASSERT_GE(repeated.size(), 3u);
+  EXPECT_TRUE(repeated[2].hold);
+  for (std::size_t i = 1; i < repeated.size(); i++)
+    EXPECT_GE(repeated[i].time, repeated[i - 1].time);
+  EXPECT_GE(repeated[2].time, at(60));
+}
+
+TEST(InputQueueTest, ReleaseStopsAutoShift) {
+  // Arrange
+  s21::InputQueue queue(isShiftKey, true);
+
+  queue.push({ShiftKey, s21::InputEvent::Press, at(0)});
+  queue.push({ShiftKey, s21::InputEvent::Repeat, at(30)});
+  queue.push({ShiftKey, s21::InputEvent::Release, at(300)});
+
+  // Act
+  std::vector<s21::KeyInput> early = pollAll(queue, 100);
+  std::vector<s21::KeyInput> late = pollAll(queue, 1000);
+
+  // Assert
+  ASSERT_EQ(early.size(), 1u);
+  EXPECT_FALSE(early[0].hold);
+  ASSERT_EQ(late.size(), 3u);
+  EXPECT_EQ(late[0].time, at(170));
+  EXPECT_EQ(late[2].time, at(270));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(InputQueueTest, OtherKeysActOnPress) {
+  // Arrange
+  s21::InputQueue queue(isShiftKey, false);
+
+  for (int ms = 0; ms <= 600; ms += 30)
+    queue.push({OtherKey, s21::InputEvent::Press, at(ms)});
+  queue.push({OtherKey, s21::InputEvent::Press, at(900)});
+  queue.push({ShiftKey, s21::InputEvent::Press, at(910)});
+
+  // Act
+  std::vector<s21::KeyInput> inputs = pollAll(queue, 2000);
+
+  // Assert
+  ASSERT_EQ(inputs.size(), 3u);
+  EXPECT_EQ(inputs[0].time, at(0));
+  EXPECT_EQ(inputs[1].time, at(900));
+  EXPECT_EQ(inputs[2].key, ShiftKey);
+  for (const s21::KeyInput &input : inputs) EXPECT_FALSE(input.hold);
+}
+
+TEST(KeymapTest, DenseAndSparseKeys) {
+  // Arrange
+  const s21::KeyBinding bindings[] = {{'p', PAUSE}, {0x01000013, ArrowUp}};
+  s21::Keymap keymap(bindings, 2);
+
+  // Act
+  keymap.bind(0x01000014, ArrowLeft);
+  keymap.unbind(ArrowLeft);
+
+  // Assert
+  EXPECT_EQ(keymap.translate('p'), PAUSE);
+  EXPECT_EQ(keymap.translate(0x01000013), ArrowUp);
+  EXPECT_EQ(keymap.translate(0x01000014), s21::Keymap::Unbound);
+  EXPECT_EQ(keymap.translate('x'), s21::Keymap::Unbound);
+  EXPECT_EQ(keymap.translate(-1), s21::Keymap::Unbound);
+}
+
+TEST(KeymapTest, LoadReplacesBindings) {
+  // Arrange
+  const s21::KeyBinding bindings[] = {{'p', PAUSE}, {'q', QUIT}};
+  const s21::KeyName names[] = {{"Escape", 27}};
+  const char *path = "keymap_test";
+  s21::Keymap keymap(bindings, 2);
+
+  std::ofstream(path) << "# bindings\n"
+                      << "Pause = x\n"
+                      << "pause = Escape\n"
+                      << "Left = 0404\n"
+                      << "Jump = j\n"
+                      << "Right =\n";
+
+  // Act
+  int loaded = keymap.load(path, names, 1, true);
+  int missing = keymap.load("keymap_missing", names, 1, false);
+
+  std::filesystem::remove(path);
+
+  // Assert
+  EXPECT_EQ(loaded, 3);
+  EXPECT_EQ(missing, -1);
+  EXPECT_EQ(keymap.translate('p'), s21::Keymap::Unbound);
+  EXPECT_EQ(keymap.translate('X'), PAUSE);
+  EXPECT_EQ(keymap.translate(27), PAUSE);
+  EXPECT_EQ(keymap.translate(0404), ArrowLeft);
+  EXPECT_EQ(keymap.translate('q'), QUIT);
+}
@@ -0,0 +1,181 @@
+#include "tests_entry.h"
+
+class LeaderboardTest : public RecordsTest {};
+
+static LeaderboardEntry makeEntry(const char *name, int score) {
+  LeaderboardEntry entry;
+
+  LeaderboardEntryInit(&entry, score, 1, 0, 1000);
+  snprintf(entry.name, sizeof(entry.name), "%s", name);
+
+  return entry;
+}
+
+TEST_F(LeaderboardTest, SortedInsert) {
+  // Arrange
+  const char *path = "leaderboard_test/board";
+  Leaderboard board;
+
+  // Act
+  int opened = LeaderboardOpen(&board, path);
+
+  LeaderboardEntry low = makeEntry("ann", 100);
+  LeaderboardEntry high = makeEntry("bob", 300);
+  LeaderboardEntry tie = makeEntry("cid", 100);
+
+  int lowRank = LeaderboardInsert(&board, LeaderboardTetris, &low);
+  int highRank = LeaderboardInsert(&board, LeaderboardTetris, &high);
+  int tieRank = LeaderboardInsert(&board, LeaderboardTetris, &tie);
+
+  LeaderboardEntry snake = makeEntry("ann", 7);
+  int snakeRank = LeaderboardInsert(&board, LeaderboardSnake, &snake);
+
+  const LeaderboardTable *tetris = LeaderboardTableOf(&board, LeaderboardTetris);
+
+  // Assert
+  ASSERT_EQ(opened, 0);
+  EXPECT_EQ(lowRank, 0);
+  EXPECT_EQ(highRank, 0);
+  EXPECT_EQ(tieRank, 2);
+  EXPECT_EQ(snakeRank, 0);
+
+  EXPECT_EQ(tetris->count, 3u);
+  EXPECT_EQ(tetris->sequence % 2, 0u);
+  EXPECT_STREQ(tetris->entries[0].name, "bob");
+  EXPECT_STREQ(tetris->entries[1].name, "ann");
+  EXPECT_STREQ(tetris->entries[2].name, "cid");
+  EXPECT_EQ(LeaderboardFind(tetris, "ann", 0), 1);
+  EXPECT_EQ(LeaderboardFind(tetris, "ann", 2), -1);
+  EXPECT_EQ(LeaderboardTableOf(&board, LeaderboardSnake)->count, 1u);
+
+  LeaderboardClose(&board);
+
+  ASSERT_EQ(LeaderboardOpen(&board, path), 0);
+  EXPECT_EQ(LeaderboardTableOf(&board, LeaderboardTetris)->entries[0].score,
+            300);
+  LeaderboardClose(&board);
+}
+
+TEST_F(LeaderboardTest, FullTable) {
+  // Arrange
+  const char *path = "leaderboard_test/board";
+  Leaderboard board;
+
+  ASSERT_EQ(LeaderboardOpen(&board, path), 0);
+
+  // Act
+  for (int i = 1; i <= LeaderboardSize; i++) {
+    LeaderboardEntry entry = makeEntry("ann", i * 10);
+
+    LeaderboardInsert(&board, LeaderboardSnake, &entry);
+  }
+
+  LeaderboardEntry worst = makeEntry("bob", 10);
+  LeaderboardEntry middle = makeEntry("bob", 505);
+
+  int worstRank = LeaderboardInsert(&board, LeaderboardSnake, &worst);
+  int middleRank = LeaderboardInsert(&board, LeaderboardSnake, &middle);
+
+  const LeaderboardTable *table = LeaderboardTableOf(&board, LeaderboardSnake);
+
+  // Assert
+  EXPECT_EQ(worstRank, -1);
+  EXPECT_EQ(middleRank, 50);
+  EXPECT_EQ(table->count, (uint32_t)LeaderboardSize);
+  EXPECT_EQ(table->entries[0].score, LeaderboardSize * 10);
+  EXPECT_EQ(table->entries[LeaderboardSize - 1].score, 20);
+
+  for (int i = 1; i < LeaderboardSize; i++)
+    EXPECT_GE(table->entries[i - 1].score, table->entries[i].score);
+
+  EXPECT_EQ(LeaderboardFind(table, "bob", 0), 50);
+  EXPECT_EQ(LeaderboardFind(table, "bob", 51), -1);
+  EXPECT_EQ(LeaderboardFind(table, "ann", 50), 51);
+
+  LeaderboardClose(&board);
+
+  std::ofstream(path, std::ios::trunc) << "HighScore = 1";
+
+  EXPECT_EQ(LeaderboardOpen(&board, path), 1);
+}
+
+TEST_F(LeaderboardTest, FindMatchesScan) {
+  // Arrange
+  const char *path = "leaderboard_test/board";
+  const char *names[] = {"ann", "bob", "cid", "dee", "eve"};
+  Leaderboard board;
+  Random random;
+
+  ASSERT_EQ(LeaderboardOpen(&board, path), 0);
+  RandomSeed(&random, 11);
+
+  for (int i = 0; i < 3 * LeaderboardSize; i++) {
+    LeaderboardEntry entry =
+        makeEntry(names[RandomBelow(&random, 5)], RandomBelow(&random, 1000));
+
+    LeaderboardInsert(&board, LeaderboardTetris, &entry);
+  }
+
+  LeaderboardTable table;
+
+  // Act
+  int read = LeaderboardRead(&board, LeaderboardTetris, &table);
+
+  // Assert
+  ASSERT_EQ(read, 0);
+  ASSERT_EQ(table.count, (uint32_t)LeaderboardSize);
+
+  for (const char *name : names)
+    for (int from = 0; from <= LeaderboardSize; from++) {
+      int expected = -1;
+
+      for (int i = from; i < LeaderboardSize && expected == -1; i++)
+        if (strcmp(table.entries[i].name, name) == 0) expected = i;
+
+      EXPECT_EQ(LeaderboardFind(&table, name, from), expected);
+    }
+
+  EXPECT_EQ(LeaderboardFind(&table, "zed", 0), -1);
+
+  LeaderboardClose(&board);
+}
+
+TEST_F(LeaderboardTest, ReadsWholeTables) {
+  // Arrange
+  const char *path = "leaderboard_test/board";
+  Leaderboard writer, reader;
+
+  ASSERT_EQ(LeaderboardOpen(&writer, path), 0);
+  ASSERT_EQ(LeaderboardOpen(&reader, path), 0);
+
+  std::atomic<bool> done{false};
+  int torn = 0, failed = 0;
+
+  // Act
+  std::thread thread([&] {
+    LeaderboardTable table;
+
+    while (!done.load()) {
+      failed |= LeaderboardRead(&reader, LeaderboardSnake, &table);
+
+      for (uint32_t i = 1; i < table.count; i++)
+        torn |= table.entries[i - 1].score < table.entries[i].score;
+    }
+  });
+
+  for (int i = 0; i < 500; i++) {
+    LeaderboardEntry entry = makeEntry("ann", (i * 37) % 1000);
+
+    LeaderboardInsert(&writer, LeaderboardSnake, &entry);
+  }
+
+  done = true;
+  thread.join();
+
+  // Assert
+  EXPECT_EQ(failed, 0);
+  EXPECT_EQ(torn, 0);
+
+  LeaderboardClose(&reader);
+  LeaderboardClose(&writer);
+}
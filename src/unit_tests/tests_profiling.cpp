@@ -0,0 +1,80 @@
+#include "tests_entry.h"
+
+using std::chrono::microseconds;
+
+TEST(LatencyTest, Percentiles) {
+  // Arrange
+  s21::LatencyHistogram histogram;
+
+  // Act
+  std::uint64_t empty = histogram.percentile(0.5);
+
+  for (int i = 1; i <= 1000; i++) histogram.record(microseconds(i * 10));
+  histogram.record(microseconds(-5));
+
+  // Assert
+  EXPECT_EQ(empty, 0u);
+  EXPECT_EQ(histogram.count(), 1001u);
+  EXPECT_GE(histogram.percentile(0.5), 5000u);
+  EXPECT_LE(histogram.percentile(0.5), 5000u * 9 / 8);
+  EXPECT_GE(histogram.percentile(0.99), 9900u);
+  EXPECT_LE(histogram.percentile(0.99), 9900u * 9 / 8);
+  EXPECT_EQ(histogram.percentile(0), 0u);
+}
+
+TEST(LatencyTest, Report) {
+  // Arrange
+  s21::InputLatency latency;
+  std::ostringstream out;
+
+  latency.input.record(microseconds(3));
+  latency.photon.record(microseconds(7));
+
+  // Act
+  latency.report(out, "console");
+
+  // Assert
+  EXPECT_EQ(out.str(),
+            "console latency, 1 keys\n"
+            "  input   p50 0.00 ms  p99 0.00 ms\n"
+            "  photon  p50 0.01 ms  p99 0.01 ms\n");
+}
+
+TEST(TraceTest, ScopesOfThreads) {
+  // Arrange
+  std::vector<TraceEvent> events(TraceCapacity);
+  const char *path = "trace_test.json";
+
+  TraceEnable(1);
+
+  // Act
+  {
+    s21::TraceScope trace("main");
+    std::thread worker([] { s21::TraceScope trace("worker"); });
+
+    worker.join();
+  }
+
+  TraceEnable(0);
+  TraceBegin("disabled");
+
+  int count = TraceSnapshot(events.data());
+  int error = TraceWrite(path);
+  std::ifstream file(path);
+  std::string json((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+
+  std::filesystem::remove(path);
+
+  // Assert
+  ASSERT_GE(count, 4);
+  EXPECT_STREQ(events[count - 1].name, "main");
+  EXPECT_EQ(events[count - 1].phase, 'E');
+  EXPECT_STREQ(events[count - 2].name, "worker");
+  EXPECT_NE(events[count - 1].thread, events[count - 2].thread);
+  EXPECT_LE(events[count - 2].time, events[count - 1].time);
+  EXPECT_EQ(error, 0);
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find("\"name\":\"worker\",\"ph\":\"B\""), std::string::npos);
+  EXPECT_EQ(json.find("disabled"), std::string::npos);
+}
@@ -0,0 +1,47 @@
+#include "tests_entry.h"
+
+TEST(RandomTest, Sequence) {
+  // Arrange
+  Random rng = {{1, 2, 3, 4}};
+  Random first, second;
+
+  RandomSeed(&first, 2024);
+  RandomSeed(&second, 2024);
+
+  // Act
+  uint32_t value = RandomNext(&rng);
+  bool same = true;
+
+  for (int i = 0; i < 1000; i++)
+    same = same && RandomNext(&first) == RandomNext(&second);
+
+  // Assert
+  EXPECT_EQ(value, 11520u);
+  EXPECT_TRUE(same);
+}
+
+TEST(RandomTest, BelowBound) {
+  // Arrange
+  Random rng;
+  int counts[7] = {};
+
+  RandomSeed(&rng, 7);
+
+  // Act
+  for (int i = 0; i < 70000; i++) {
+    int value = RandomBelow(&rng, 7);
+
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, 7);
+
+    counts[value]++;
+  }
+
+  // Assert
+  for (int count : counts) {
+    EXPECT_GT(count, 9000);
+    EXPECT_LT(count, 11000);
+  }
+
+  EXPECT_NE(RandomEntropy(), RandomEntropy());
+}
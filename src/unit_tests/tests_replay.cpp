@@ -0,0 +1,322 @@
+#include "tests_entry.h"
+
+class ReplayTest : public RecordsTest {};
+
+/**
+ * @brief Feed a key to the controller as the game loop does
+ * @param controller Controller
+ * @param key Game key, -1 for a tick
+ * @param hold Key is held down
+ * @return Game information after the key
+ */
+static GameInfo_t feed(s21::Controller &controller, int key, bool hold) {
+  UserAction_t action = Start;
+
+  controller.getInput(&action, key);
+  controller.userInput(action, hold);
+
+  return controller.updateCurrentState();
+}
+
+/**
+ * @brief Key turning the snake towards the apple
+ * @param info Game information
+ * @return Arrow key, -1 if the head or the apple is not on the field
+ */
+static int chaseKey(const GameInfo_t &info) {
+  int head = -1, apple = -1;
+  int rows = info.field[0][0], cols = info.field[1][0];
+
+  for (int i = 2; i < rows * cols; i++) {
+    int cell = info.field[i / cols][i % cols];
+
+    if (cell == FigureSym + 6) head = i;
+    if (cell == FigureSym + 1) apple = i;
+  }
+
+  if (head == -1 || apple == -1) return -1;
+  if (apple / cols != head / cols)
+    return apple / cols < head / cols ? ArrowUp : ArrowDown;
+
+  return apple % cols < head % cols ? ArrowLeft : ArrowRight;
+}
+
+/**
+ * @brief Play a scripted game and record it
+ * @details Tetris takes random keys, the snake chases the apple
+ * @param model Model of the game, owned by the call
+ * @param game Game
+ * @param path Path to the replay
+ * @param steps Number of the steps
+ * @param bag Tetris figures come from the 7-bag
+ * @param score Output score at the end, as the game loop shows it
+ * @return Digest of the field at the end
+ */
+static uint32_t recordGame(s21::IModel *model, s21::ReplayGame game,
+                           const std::string &path, int steps,
+                           bool bag = false, int *score = nullptr) {
+  const int keys[] = {-1, -1, -1, ArrowLeft, ArrowRight, ArrowUp, ACTION,
+                      ArrowDown};
+  s21::Controller controller(model);
+  Random script;
+
+  controller.setBag(bag);
+  controller.setSeed(7);
+  controller.setRecords(nullptr);
+  RandomSeed(&script, 3);
+
+  s21::ReplayRecorder recorder(path, game, controller.getSeed(), bag);
+
+  controller.record(&recorder);
+
+  GameInfo_t info = controller.updateCurrentState();
+
+  for (int i = 0; i < steps; i++) {
+    int k = RandomBelow(&script, 8);
+    State state = model->getState();
+    bool idle = state == Launch || state == GameOver || state == Win;
+    int key = game == s21::ReplayGame::Snake && i % 3 ? -1
+              : game == s21::ReplayGame::Snake      ? chaseKey(info)
+                                                    : keys[k];
+
+    info = feed(controller, idle ? Keys::ENTER : key, k == 3 && i % 2);
+
+    if (score != nullptr && info.score != -1) *score = info.score;
+  }
+
+  recorder.finish();
+
+  return s21::Replay::digest(controller.updateCurrentState());
+}
+
+TEST_F(ReplayTest, SaveAndLoad) {
+  // Arrange
+  s21::Replay replay, loaded, cut;
+
+  replay.game = s21::ReplayGame::Snake;
+  replay.seed = 0x0123456789ABCDEFu;
+  replay.bag = true;
+  replay.steps = {{0, ENTER, false}, {300, -1, false}, {320, ArrowLeft, true},
+                  {100000, QUIT, false}};
+  replay.checks = {{2, 0xDEADBEEFu}};
+
+  // Act
+  bool saved = replay.save("records/test_replay");
+  bool read = loaded.load("records/test_replay");
+
+  std::filesystem::path path = "records/test_replay";
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+  bool readCut = cut.load("records/test_replay");
+
+  // Assert
+  ASSERT_TRUE(saved);
+  ASSERT_TRUE(read);
+  EXPECT_EQ(loaded.game, replay.game);
+  EXPECT_EQ(loaded.seed, replay.seed);
+  EXPECT_TRUE(loaded.bag);
+  ASSERT_EQ(loaded.steps.size(), replay.steps.size());
+
+  for (size_t i = 0; i < replay.steps.size(); i++) {
+    EXPECT_EQ(loaded.steps[i].time, replay.steps[i].time);
+    EXPECT_EQ(loaded.steps[i].key, replay.steps[i].key);
+    EXPECT_EQ(loaded.steps[i].hold, replay.steps[i].hold);
+  }
+
+  ASSERT_EQ(loaded.checks.size(), 1u);
+  EXPECT_EQ(loaded.checks[0].step, 2u);
+  EXPECT_EQ(loaded.checks[0].digest, 0xDEADBEEFu);
+  EXPECT_TRUE(readCut);
+  EXPECT_EQ(cut.steps.size(), replay.steps.size() - 1);
+  EXPECT_FALSE(loaded.load("records/missing_replay"));
+}
+
+TEST_F(ReplayTest, PlaysRecordedGame) {
+  // Arrange
+  uint32_t tetris = recordGame(new s21::TetrisModel(), s21::ReplayGame::Tetris,
+                               "records/test_replay", 3000);
+  uint32_t snake = recordGame(new s21::SnakeModel(), s21::ReplayGame::Snake,
+                              "records/test_snake_replay", 1000);
+  s21::Replay tetrisReplay, snakeReplay;
+
+  ASSERT_TRUE(tetrisReplay.load("records/test_replay"));
+  ASSERT_TRUE(snakeReplay.load("records/test_snake_replay"));
+
+  s21::Controller tetrisGame(new s21::TetrisModel());
+  s21::Controller snakeGame(new s21::SnakeModel());
+  s21::ReplayPlayer tetrisPlayer(tetrisGame, tetrisReplay);
+  s21::ReplayPlayer snakePlayer(snakeGame, snakeReplay);
+
+  // Act
+  size_t tetrisSteps = tetrisPlayer.run(tetrisReplay.steps.size());
+  size_t snakeSteps = snakePlayer.run(snakeReplay.steps.size());
+
+  // Assert
+  EXPECT_EQ(tetrisSteps, 3000u);
+  EXPECT_EQ(snakeSteps, 1000u);
+  EXPECT_EQ(tetrisReplay.checks.size(), 3000 / s21::Replay::CheckpointSteps);
+  EXPECT_TRUE(tetrisPlayer.done());
+  EXPECT_EQ(tetrisPlayer.diverged(), -1);
+  EXPECT_EQ(snakePlayer.diverged(), -1);
+  EXPECT_EQ(s21::Replay::digest(tetrisGame.updateCurrentState()), tetris);
+  EXPECT_EQ(s21::Replay::digest(snakeGame.updateCurrentState()), snake);
+  EXPECT_LT(std::filesystem::file_size("records/test_replay"), 3 * 3000u);
+}
+
+TEST_F(ReplayTest, PlaysBaggedGame) {
+  // Arrange
+  uint32_t expected =
+      recordGame(new s21::TetrisModel(), s21::ReplayGame::Tetris,
+                 "records/test_replay", 2000, true);
+  uint32_t uniform =
+      recordGame(new s21::TetrisModel(), s21::ReplayGame::Tetris,
+                 "records/test_uniform_replay", 2000);
+  s21::Replay replay;
+
+  ASSERT_TRUE(replay.load("records/test_replay"));
+
+  s21::Controller controller(new s21::TetrisModel());
+  s21::ReplayPlayer player(controller, replay);
+
+  // Act
+  player.run(replay.steps.size());
+
+  // Assert
+  EXPECT_TRUE(replay.bag);
+  EXPECT_NE(expected, uniform);
+  EXPECT_EQ(player.diverged(), -1);
+  EXPECT_EQ(s21::Replay::digest(controller.updateCurrentState()), expected);
+}
+
+TEST_F(ReplayTest, CarriesSnakeScore) {
+  // Arrange
+  int score = -1;
+
+  recordGame(new s21::SnakeModel(), s21::ReplayGame::Snake,
+             "records/test_snake_replay", 300, false, &score);
+  s21::Replay replay;
+
+  ASSERT_TRUE(replay.load("records/test_snake_replay"));
+
+  for (size_t i = 0; i < replay.steps.size(); i++)
+    replay.steps[i].time = i * 10;
+
+  s21::Controller controller(new s21::SnakeModel());
+  s21::Controller straight(new s21::SnakeModel());
+  s21::ReplayPlayer player(controller, replay);
+  s21::ReplayPlayer reference(straight, replay);
+
+  reference.run(150);
+
+  // Act
+  player.run(replay.steps.size());
+
+  int ended = player.info().score;
+
+  player.seek(1500);
+
+  // Assert
+  EXPECT_GT(score, 0);
+  EXPECT_EQ(ended, score);
+  EXPECT_EQ(player.position(), 150u);
+  EXPECT_NE(player.info().score, -1);
+  EXPECT_EQ(player.info().score, reference.info().score);
+  EXPECT_EQ(player.info().level, reference.info().level);
+}
+
+TEST_F(ReplayTest, KeepsExistingFiles) {
+  // Arrange
+  const char *path = "records/test_replay";
+
+  std::filesystem::create_directories("records");
+  std::ofstream(path) << "kept";
+
+  // Act
+  s21::ReplayRecorder first(path, s21::ReplayGame::Snake, 1);
+  s21::ReplayRecorder second(path, s21::ReplayGame::Tetris, 2, true);
+
+  std::string firstPath = first.path(), secondPath = second.path();
+
+  first.finish();
+  second.finish();
+
+  s21::Replay firstReplay, secondReplay;
+  std::ifstream kept(path);
+  std::string text;
+
+  kept >> text;
+
+  // Assert
+  EXPECT_EQ(text, "kept");
+  EXPECT_EQ(firstPath, std::string(path) + "-1");
+  EXPECT_EQ(secondPath, std::string(path) + "-2");
+  ASSERT_TRUE(firstReplay.load(firstPath));
+  ASSERT_TRUE(secondReplay.load(secondPath));
+  EXPECT_EQ(firstReplay.seed, 1u);
+  EXPECT_EQ(secondReplay.game, s21::ReplayGame::Tetris);
+  EXPECT_TRUE(first.path().empty());
+}
+
+TEST_F(ReplayTest, SeekMatchesStraightRun) {
+  // Arrange
+  uint32_t expected =
+      recordGame(new s21::TetrisModel(), s21::ReplayGame::Tetris,
+                 "records/test_replay", 2000);
+  s21::Replay replay;
+
+  ASSERT_TRUE(replay.load("records/test_replay"));
+
+  for (size_t i = 0; i < replay.steps.size(); i++)
+    replay.steps[i].time = i * 10;
+
+  s21::Controller controller(new s21::TetrisModel());
+  s21::ReplayPlayer player(controller, replay);
+
+  player.run(1500);
+
+  uint32_t middle = s21::Replay::digest(controller.updateCurrentState());
+
+  // Act
+  player.run(replay.steps.size());
+  player.seek(15000);
+
+  uint32_t sought = s21::Replay::digest(controller.updateCurrentState());
+  size_t position = player.position();
+
+  player.seek(0);
+  player.seek(replay.steps.back().time + 1);
+
+  // Assert
+  EXPECT_EQ(position, 1500u);
+  EXPECT_EQ(sought, middle);
+  EXPECT_TRUE(player.done());
+  EXPECT_EQ(player.diverged(), -1);
+  EXPECT_EQ(s21::Replay::digest(controller.updateCurrentState()), expected);
+}
+
+TEST_F(ReplayTest, ReportsDivergence) {
+  // Arrange
+  recordGame(new s21::TetrisModel(), s21::ReplayGame::Tetris,
+             "records/test_replay", 1000);
+  s21::Replay replay;
+
+  ASSERT_TRUE(replay.load("records/test_replay"));
+  ASSERT_GE(replay.checks.size(), 2u);
+
+  replay.checks[1].digest ^= 1;
+
+  s21::Controller controller(new s21::TetrisModel());
+  s21::ReplayPlayer player(controller, replay);
+
+  // Act
+  player.run(replay.checks[0].step);
+
+  long before = player.diverged();
+
+  player.run(replay.steps.size());
+
+  // Assert
+  EXPECT_EQ(before, -1);
+  EXPECT_EQ(player.diverged(), 1);
+}
@@ -0,0 +1,225 @@
+#include "tests_entry.h"
+
+class ScoreStoreTest : public RecordsTest {};
+class PersistTest : public RecordsTest {};
+
+static int readScoreFile(const char *path) {
+  std::ifstream file(path);
+  int score = -1;
+
+  if (file.is_open()) {
+    std::string line;
+
+    std::getline(file, line);
+    sscanf(line.c_str(), "HighScore = %d", &score);
+  }
+
+  return score;
+}
+
+TEST_F(ScoreStoreTest, KeepsBestScore) {
+  // Arrange
+  const char *path = "score_store/records";
+
+  // Act
+  int missing = ScoreStoreLoad(path);
+  int saved = ScoreStoreSave(path, 120);
+  int lower = ScoreStoreSave(path, 80);
+  int cached = ScoreStoreLoad(path);
+
+  std::ofstream(path) << "HighScore = 300";
+
+  int stale = ScoreStoreLoad(path);
+
+  ScoreStoreForget();
+
+  int fresh = ScoreStoreLoad(path);
+
+  // Assert
+  EXPECT_EQ(missing, 0);
+  EXPECT_EQ(saved, 0);
+  EXPECT_EQ(lower, 0);
+  EXPECT_EQ(cached, 120);
+  EXPECT_EQ(stale, 120);
+  EXPECT_EQ(fresh, 300);
+  EXPECT_FALSE(std::filesystem::exists("score_store/records.tmp"));
+  EXPECT_FALSE(std::filesystem::exists("score_store/records.lock"));
+}
+
+TEST_F(ScoreStoreTest, MigratesLegacyFile) {
+  // Arrange
+  const char *path = "score_store/tetris";
+  const char *other = "score_store/snake";
+  const char *legacy = "score_store/records";
+
+  std::filesystem::create_directories("score_store");
+
+  std::ofstream(legacy) << "HighScore = 450";
+  std::ofstream(other) << "HighScore = 30";
+
+  // Act
+  int migrated = ScoreStoreMigrate(path, legacy);
+
+  std::ofstream(legacy) << "HighScore = 900";
+  ScoreStoreForget();
+
+  int reloaded = ScoreStoreMigrate(path, legacy);
+  int kept = ScoreStoreMigrate(other, legacy);
+
+  // Assert
+  EXPECT_EQ(migrated, 450);
+  EXPECT_EQ(readScoreFile(path), 450);
+  EXPECT_EQ(reloaded, 450);
+  EXPECT_EQ(kept, 30);
+  EXPECT_EQ(readScoreFile(legacy), 900);
+}
+
+TEST_F(ScoreStoreTest, ConcurrentWriters) {
+  // Arrange
+  const char *path = "score_store/records";
+  const int writers = 4, saves = 50;
+  std::vector<pid_t> children;
+
+  // Act
+  for (int w = 0; w < writers; w++) {
+    pid_t pid = fork();
+
+    if (pid == 0) {
+      int failed = 0;
+
+      for (int i = 1; i <= saves; i++)
+        failed |= ScoreStoreSave(path, i * writers + w);
+
+      _exit(failed);
+    }
+
+    children.push_back(pid);
+  }
+
+  int failed = 0;
+
+  for (pid_t pid : children) {
+    int status = 0;
+
+    waitpid(pid, &status, 0);
+    failed |= !WIFEXITED(status) || WEXITSTATUS(status);
+  }
+
+  // Assert
+  EXPECT_EQ(failed, 0);
+  EXPECT_EQ(readScoreFile(path), saves * writers + writers - 1);
+  EXPECT_FALSE(std::filesystem::exists("score_store/records.lock"));
+}
+
+TEST_F(PersistTest, CoalescesAndFlushes) {
+  // Arrange
+  const char *path = "score_store/records";
+  const char *board = "score_store/board";
+  LeaderboardEntry first, second;
+
+  LeaderboardEntryInit(&first, 40, 1, 4, 1000);
+  LeaderboardEntryInit(&second, 90, 2, 9, 2000);
+
+  // Act
+  int rejected = 0;
+
+  for (int score = 1; score <= 1000; score++)
+    rejected |= PersistHighScore(path, score % 500);
+
+  rejected |= PersistRecord(board, LeaderboardTetris, &first);
+  rejected |= PersistRecord(board, LeaderboardTetris, &second);
+
+  PersistFlush();
+
+  int flushed = readScoreFile(path);
+
+  rejected |= PersistHighScore(path, 700);
+
+  PersistStop();
+
+  Leaderboard leaderboard;
+  int opened = LeaderboardOpen(&leaderboard, board);
+
+  // Assert
+  EXPECT_EQ(rejected, 0);
+  EXPECT_EQ(flushed, 499);
+  EXPECT_EQ(readScoreFile(path), 700);
+  ASSERT_EQ(opened, 0);
+
+  const LeaderboardTable *table =
+      LeaderboardTableOf(&leaderboard, LeaderboardTetris);
+
+  EXPECT_EQ(table->count, 2u);
+  EXPECT_EQ(table->entries[0].score, 90);
+  EXPECT_EQ(table->entries[1].lines, 4);
+
+  LeaderboardClose(&leaderboard);
+}
+
+TEST_F(PersistTest, FullQueueKeepsSaves) {
+  // Arrange
+  const char *board = "score_store/board";
+  const int games = 2 * PersistCapacity + 10;
+  std::vector<std::thread> threads;
+
+  // Act
+  for (int t = 0; t < 2; t++)
+    threads.emplace_back([board, t] {
+      for (int score = 1 + t; score <= games; score += 2) {
+        LeaderboardEntry entry;
+
+        LeaderboardEntryInit(&entry, score, 1, 0, 1000);
+        PersistRecord(board, LeaderboardSnake, &entry);
+      }
+    });
+
+  for (std::thread &thread : threads) thread.join();
+
+  PersistStop();
+
+  Leaderboard leaderboard;
+  int opened = LeaderboardOpen(&leaderboard, board);
+
+  // Assert
+  ASSERT_EQ(opened, 0);
+
+  const LeaderboardTable *table =
+      LeaderboardTableOf(&leaderboard, LeaderboardSnake);
+
+  ASSERT_EQ(table->count, (uint32_t)LeaderboardSize);
+
+  for (int i = 0; i < LeaderboardSize; i++)
+    EXPECT_EQ(table->entries[i].score, games - i);
+
+  LeaderboardClose(&leaderboard);
+}
+
+TEST_F(PersistTest, AppendsInOrder) {
+  // Arrange
+  const char *path = "score_store/bytes";
+  std::string expected;
+
+  std::filesystem::create_directories("score_store");
+
+  // Act
+  int rejected = 0;
+
+  for (int i = 0; i < 3 * PersistCapacity; i++) {
+    std::string chunk = std::to_string(i) + ",";
+
+    rejected |= PersistAppend(path, chunk.data(), chunk.size());
+    expected += chunk;
+  }
+
+  rejected |= PersistAppend(path, "", 0);
+
+  PersistFlush();
+
+  std::ifstream file(path, std::ios::binary);
+  std::string written{std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>()};
+
+  // Assert
+  EXPECT_EQ(rejected, 0);
+  EXPECT_EQ(written, expected);
+}
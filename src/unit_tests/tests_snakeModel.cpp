@@ -3,15 +3,25 @@
 void printField(int **field);
 void moveHead(s21::Point &head, UserAction_t action);
 void fieldByPass(s21::SnakeModel *model, int count);
+int applyDelta(int *mirror, int cols, const FrameDelta &delta);
 
-class SnakeTest : public ::testing::Test {
+class SnakeTest : public RecordsTest {
  protected:
   s21::SnakeModel *model;
 
-  void SetUp() override { model = new s21::SnakeModel(); }
-  void TearDown() override { delete model; }
+  void SetUp() override {
+    RecordsTest::SetUp();
+    model = new s21::SnakeModel();
+  }
+
+  void TearDown() override {
+    delete model;
+    RecordsTest::TearDown();
+  }
 };
 
+class HighScoreTest : public RecordsTest {};
+
 TEST_F(SnakeTest, Constructor) {
   // Act
   GameInfo_t gameInfo = model->updateCurrentState();
@@ -25,7 +35,7 @@ TEST_F(SnakeTest, Constructor) {
   EXPECT_EQ(height, static_cast<int>(s21::Field::height));
   EXPECT_EQ(width, static_cast<int>(s21::Field::width));
 
-  EXPECT_TRUE(gameInfo.high_score == 0 || gameInfo.high_score == 196);
+  EXPECT_EQ(gameInfo.high_score, 0);
   EXPECT_EQ(gameInfo.score, 0);
   EXPECT_EQ(gameInfo.level, 1);
   EXPECT_EQ(gameInfo.pause, 0);
@@ -55,7 +65,9 @@ TEST_F(SnakeTest, LaunchStage) {
   action = Terminate;
   model->userInput(action, hold);
 
-  std::string filePath = "records/records";
+  PersistFlush();
+
+  std::string filePath = "records/snake";
   std::ifstream file(filePath);
 
   if (file.is_open()) {
@@ -65,14 +77,10 @@ TEST_F(SnakeTest, LaunchStage) {
     while (std::getline(file, line)) {
       if (line.find("HighScore = ") != std::string::npos) {
         sscanf(line.c_str(), "HighScore = %d", &high_score);
-        EXPECT_TRUE(high_score == 0 || high_score == 196);
+        EXPECT_EQ(high_score, 0);
         break;
       }
     }
-
-    file.close();
-    std::filesystem::remove(filePath);
-    std::filesystem::remove(filePath.substr(0, filePath.find_last_of("/")));
   }
 
   // Assert
@@ -275,7 +283,9 @@ TEST_F(SnakeTest, PauseWithTerminate) {
   model->setKey(QUIT);
   model->userInput(UserAction_t::Terminate, false);
 
-  std::string filePath = "records/records";
+  PersistFlush();
+
+  std::string filePath = "records/snake";
   std::ifstream file(filePath);
 
   if (file.is_open()) {
@@ -285,14 +295,10 @@ TEST_F(SnakeTest, PauseWithTerminate) {
     while (std::getline(file, line)) {
       if (line.find("HighScore = ") != std::string::npos) {
         sscanf(line.c_str(), "HighScore = %d", &high_score);
-        EXPECT_EQ(high_score, 0);
+        EXPECT_EQ(high_score, gameInfo_third.score);
         break;
       }
     }
-
-    file.close();
-    std::filesystem::remove(filePath);
-    std::filesystem::remove(filePath.substr(0, filePath.find_last_of("/")));
   }
 }
 
@@ -416,7 +422,13 @@ TEST_F(SnakeTest, InnerCollision) {
   EXPECT_EQ(model->getState(), State::GameOver);
 }
 
-TEST(getHighCoreTest, getHighScore) {
+TEST_F(HighScoreTest, getHighScore) {
+  // Arrange
+  std::filesystem::create_directories("test_records");
+  std::ofstream("test_records/records") << "HighScore = 12";
+  std::ofstream("test_records/invalid_records");
+  std::ofstream("test_records/wrongformat_records") << "HighScore = abc";
+
   // Act
   int high_score = s21::getHighScore("test_records/records");
 
@@ -462,6 +474,60 @@ TEST_F(SnakeTest, WinStage) {
   EXPECT_TRUE(counter >= 199);
 }
 
+TEST_F(SnakeTest, AppleOnFreeCell) {
+  // Arrange
+  RandomWalk walk(s21::ReplayGame::Snake, 21);
+
+  // Act
+  for (int t = 0; t < 20000; t++) {
+    walk.step(*model);
+
+    if (model->getState() != State::Moving) continue;
+
+    GameInfo_t gameInfo = model->updateCurrentState();
+    int apples = 0;
+
+    for (int i = 0; i < static_cast<int>(s21::Field::height) - 1; i++)
+      for (int j = 1; j < static_cast<int>(s21::Field::width) - 1; j++)
+        if (gameInfo.field[i][j] == FigureSym + 1) apples++;
+
+    // Assert
+    ASSERT_EQ(apples, 1);
+  }
+}
+
+TEST_F(SnakeTest, FrameDeltaMirror) {
+  // Arrange
+  const int height = static_cast<int>(s21::Field::height);
+  const int width = static_cast<int>(s21::Field::width);
+  RandomWalk walk(s21::ReplayGame::Snake, 12);
+  int mirror[height][width] = {};
+
+  EXPECT_EQ(applyDelta(mirror[0], width, model->updateFrameDelta()),
+            height * width);
+  EXPECT_EQ(model->updateFrameDelta().count, 0);
+  EXPECT_EQ(model->updateFrameDelta().next, -1);
+
+  // Act
+  for (int t = 0; t < 5000; t++) {
+    bool moving = model->getState() == State::Moving;
+
+    walk.step(*model);
+
+    int changed = applyDelta(mirror[0], width, model->updateFrameDelta());
+    GameInfo_t gameInfo = model->updateCurrentState();
+
+    // Assert
+    if (moving && model->getState() == State::Moving) {
+      ASSERT_LE(changed, 4);
+    }
+
+    for (int i = 0; i < height; i++)
+      for (int j = 0; j < width; j++)
+        ASSERT_EQ(mirror[i][j], gameInfo.field[i][j]);
+  }
+}
+
 void printField(int **field) {
   int height = static_cast<int>(s21::Field::height);
   int width = static_cast<int>(s21::Field::width);
@@ -0,0 +1,417 @@
+#include "tests_entry.h"
+
+void startTetris(s21::TetrisModel *model);
+int countFigureCells(int **field);
+int applyDelta(int *mirror, int cols, const FrameDelta &delta);
+
+class TetrisTest : public RecordsTest {
+ protected:
+  s21::TetrisModel *model;
+
+  void SetUp() override {
+    RecordsTest::SetUp();
+    model = new s21::TetrisModel();
+  }
+
+  void TearDown() override {
+    delete model;
+    RecordsTest::TearDown();
+  }
+};
+
+class TetrisPersistTest : public RecordsTest {};
+
+TEST_F(TetrisTest, Constructor) {
+  // Act
+  GameInfo_t gameInfo = model->updateCurrentState();
+
+  // Assert
+  EXPECT_EQ(gameInfo.field[0][0], FieldRows);
+  EXPECT_EQ(gameInfo.field[1][0], FieldCols);
+  EXPECT_EQ(gameInfo.score, 0);
+  EXPECT_EQ(gameInfo.level, 1);
+  EXPECT_EQ(gameInfo.pause, 0);
+  EXPECT_EQ(gameInfo.speed, 575);
+  EXPECT_EQ(countFigureCells(gameInfo.field), 0);
+  EXPECT_EQ(model->getState(), State::Launch);
+}
+
+TEST_F(TetrisTest, SpawnStage) {
+  // Act
+  startTetris(model);
+
+  GameInfo_t gameInfo = model->updateCurrentState();
+
+  // Assert
+  EXPECT_EQ(model->getState(), State::Moving);
+  EXPECT_EQ(countFigureCells(gameInfo.field), 4);
+}
+
+TEST_F(TetrisTest, IndependentInstances) {
+  // Act
+  s21::TetrisModel second;
+
+  startTetris(model);
+
+  for (int i = 0; i < 5; i++) {
+    model->setKey(-1);
+    model->userInput(UserAction_t::Start, false);
+  }
+
+  GameInfo_t first = model->updateCurrentState();
+  GameInfo_t other = second.updateCurrentState();
+
+  // Assert
+  EXPECT_NE(first.field, other.field);
+  EXPECT_EQ(model->getState(), State::Moving);
+  EXPECT_EQ(second.getState(), State::Launch);
+  EXPECT_EQ(countFigureCells(first.field), 4);
+  EXPECT_EQ(countFigureCells(other.field), 0);
+}
+
+TEST(TetrisContextTest, ParallelGames) {
+  // Arrange
+  const int games = 4;
+  TetrisContext contexts[games];
+  std::vector<std::thread> threads;
+
+  // Act
+  for (int g = 0; g < games; g++)
+    threads.emplace_back([&contexts, g]() {
+      TetrisContextInit(&contexts[g]);
+
+      TetrisSetKey(&contexts[g], ENTER);
+      TetrisUserInput(&contexts[g], Start, false);
+
+      for (int i = 0; i < 10000; i++) {
+        TetrisSetKey(&contexts[g], -1);
+        TetrisUserInput(&contexts[g], i % 3 ? Start : Action, false);
+      }
+    });
+
+  for (auto &thread : threads) thread.join();
+
+  // Assert
+  for (int g = 0; g < games; g++) {
+    EXPECT_NE(TetrisGetState(&contexts[g]), Launch);
+    TetrisContextDestroy(&contexts[g]);
+  }
+}
+
+TEST(TetrisContextTest, FilledLinesRemoval) {
+  // Arrange
+  TetrisContext ctx;
+  TetrisContextInit(&ctx);
+
+  ctx.board.rows[FieldRows - 2] = RowWallMask | RowFullMask;
+  ctx.board.rows[FieldRows - 3] = RowWallMask | RowFullMask;
+  ctx.board.rows[FieldRows - 4] = RowWallMask | (1 << LeftBorder);
+  ctx.board.colors[ctx.board.slots[FieldRows - 4]][LeftBorder] = Green;
+
+  // Act
+  uint32_t cleared = RemovingFilledLines(&ctx);
+
+  GameInfo_t gameInfo = TetrisUpdateCurrentState(&ctx);
+
+  // Assert
+  EXPECT_EQ(cleared, (1u << (FieldRows - 2)) | (1u << (FieldRows - 3)));
+  EXPECT_EQ(gameInfo.score, 300);
+  EXPECT_EQ(ctx.board.rows[FieldRows - 2], RowWallMask | (1 << LeftBorder));
+  EXPECT_EQ(ctx.board.rows[FieldRows - 3], RowWallMask);
+  EXPECT_EQ(gameInfo.field[FieldRows - 2][LeftBorder], FigureSym + static_cast<int>(Green));
+  EXPECT_EQ(countFigureCells(gameInfo.field), 1);
+
+  TetrisContextDestroy(&ctx);
+}
+
+TEST(TetrisContextTest, FigureTables) {
+  // Arrange
+  const FigureRotation *square = figureRotations[4];
+  const FigureRotation *line = figureRotations[0];
+
+  // Assert
+  for (int k = 1; k < RotationsCount; k++)
+    for (int i = 0; i < 4; i++) {
+      EXPECT_EQ(square[k].cells[i].row, square[0].cells[i].row);
+      EXPECT_EQ(square[k].cells[i].col, square[0].cells[i].col);
+    }
+
+  EXPECT_EQ(line[0].height, 1);
+  EXPECT_EQ(line[0].masks[0], 0x0F);
+  EXPECT_EQ(line[1].height, 4);
+  EXPECT_EQ(line[1].masks[0], 0x01);
+  EXPECT_EQ(line[1].masks[3], 0x01);
+}
+
+TEST(TetrisContextTest, RotationWallKick) {
+  // Arrange
+  TetrisContext ctx;
+  TetrisContextInit(&ctx);
+
+  ctx.figure.type = 0;
+  ctx.figure.rotation = 1;
+  ctx.figure.row = 5;
+  ctx.figure.col = LeftBorder;
+  ctx.figure.color = 0;
+  ctx.figure.active = 1;
+
+  // Act
+  Rotate(&ctx);
+
+  GameInfo_t gameInfo = TetrisUpdateCurrentState(&ctx);
+
+  // Assert
+  EXPECT_EQ(ctx.figure.rotation, 2);
+  EXPECT_EQ(ctx.figure.col, LeftBorder + 1);
+  EXPECT_EQ(countFigureCells(gameInfo.field), 4);
+
+  for (int j = LeftBorder; j < LeftBorder + 4; j++)
+    EXPECT_GE(gameInfo.field[5][j], FigureSym);
+
+  TetrisContextDestroy(&ctx);
+}
+
+TEST(TetrisSimulatorTest, BatchStep) {
+  // Arrange
+  TetrisSimulator sim;
+  TetrisSimInit(&sim);
+
+  const int ticks = 20000;
+  const UserAction_t pattern[] = {Start, Left, Start, Action, Right, Start};
+  std::vector<UserAction_t> actions(ticks);
+
+  for (int i = 0; i < ticks; i++) actions[i] = pattern[i % 6];
+
+  // Act
+  int lines = TetrisSimStep(&sim, actions.data(), ticks / 2);
+  lines += TetrisSimStep(&sim, actions.data() + ticks / 2, ticks / 2);
+
+  // Assert
+  EXPECT_EQ(sim.ticks, static_cast<uint64_t>(ticks));
+  EXPECT_EQ(sim.lines, static_cast<uint64_t>(lines));
+  EXPECT_GT(sim.games, 0u);
+  EXPECT_NE(TetrisGetState(&sim.ctx), Launch);
+
+  TetrisSimDestroy(&sim);
+}
+
+TEST(TetrisSimulatorTest, KeysOfActions) {
+  // Arrange
+  TetrisSimulator sim;
+  TetrisSimInit(&sim);
+
+  UserAction_t start = Start;
+
+  // Assert
+  EXPECT_EQ(TetrisSimKey(&sim.ctx, Start), ENTER);
+  EXPECT_EQ(TetrisSimKey(&sim.ctx, Action), ACTION);
+
+  TetrisSimStep(&sim, &start, 1);
+
+  EXPECT_EQ(TetrisGetState(&sim.ctx), Moving);
+  EXPECT_EQ(TetrisSimKey(&sim.ctx, Start), -1);
+
+  TetrisSimDestroy(&sim);
+}
+
+TEST(TetrisSimulatorTest, GravityOnTicksOnly) {
+  // Arrange
+  TetrisSimulator sim;
+  TetrisSimInit(&sim);
+
+  const UserAction_t keys[] = {Left, Right, Action, Left, Right, Action};
+  UserAction_t start = Start, down = Down;
+
+  TetrisSimStep(&sim, &start, 1);
+
+  int row = sim.ctx.figure.row;
+
+  // Act
+  for (int i = 0; i < 10; i++) TetrisSimStep(&sim, keys, 6);
+
+  int afterKeys = sim.ctx.figure.row;
+
+  TetrisSimStep(&sim, &start, 1);
+
+  int afterTick = sim.ctx.figure.row;
+
+  TetrisSimStep(&sim, &down, 1);
+
+  // Assert
+  EXPECT_EQ(afterKeys, row);
+  EXPECT_EQ(afterTick, row + 1);
+  EXPECT_EQ(sim.ctx.figure.row, row + 2);
+
+  TetrisSimDestroy(&sim);
+}
+
+TEST_F(TetrisTest, FrameDeltaMirror) {
+  // Arrange
+  RandomWalk walk(s21::ReplayGame::Tetris, 7);
+  int mirror[FieldRows][FieldCols] = {};
+
+  const FrameDelta &first = model->updateFrameDelta();
+
+  EXPECT_EQ(first.count, FieldRows * FieldCols);
+  EXPECT_EQ(first.score, 0);
+  EXPECT_EQ(first.level, 1);
+
+  applyDelta(mirror[0], FieldCols, first);
+
+  EXPECT_EQ(model->updateFrameDelta().count, 0);
+  EXPECT_EQ(model->updateFrameDelta().score, -1);
+
+  startTetris(model);
+
+  // Act
+  for (int t = 0; t < 5000; t++) {
+    walk.step(*model);
+
+    applyDelta(mirror[0], FieldCols, model->updateFrameDelta());
+
+    GameInfo_t gameInfo = model->updateCurrentState();
+
+    // Assert
+    for (int i = 0; i < FieldRows; i++)
+      for (int j = 0; j < FieldCols; j++)
+        ASSERT_EQ(mirror[i][j], gameInfo.field[i][j]);
+  }
+}
+
+TEST_F(TetrisTest, SeededReplay) {
+  // Arrange
+  RandomWalk walk(s21::ReplayGame::Tetris, 1);
+  s21::TetrisModel twin;
+
+  model->setSeed(42);
+  twin.setSeed(42);
+
+  startTetris(model);
+  startTetris(&twin);
+
+  // Act
+  for (int t = 0; t < 3000; t++) {
+    WalkStep step = walk.next(model->getState());
+
+    RandomWalk::feed(*model, step);
+    RandomWalk::feed(twin, step);
+
+    GameInfo_t first = model->updateCurrentState();
+    GameInfo_t second = twin.updateCurrentState();
+
+    // Assert
+    ASSERT_EQ(first.score, second.score);
+
+    for (int i = 0; i < FieldRows; i++)
+      for (int j = 0; j < FieldCols; j++)
+        ASSERT_EQ(first.field[i][j], second.field[i][j]);
+  }
+
+  EXPECT_EQ(model->getSeed(), 42u);
+}
+
+TEST(TetrisRandomTest, SevenBag) {
+  // Arrange
+  TetrisContext ctx{};
+
+  TetrisContextInit(&ctx);
+  TetrisSetBag(&ctx, 1);
+  TetrisSetSeed(&ctx, 5);
+
+  // Act
+  for (int bag = 0; bag < 10; bag++) {
+    int seen = 0;
+
+    for (int i = 0; i < RandomBagSize; i++) {
+      DropFigure(&ctx);
+      seen |= 1 << ctx.figure.type;
+    }
+
+    // Assert
+    EXPECT_EQ(seen, (1 << RandomBagSize) - 1);
+  }
+
+  TetrisContextDestroy(&ctx);
+}
+
+int applyDelta(int *mirror, int cols, const FrameDelta &delta) {
+  for (int i = 0; i < delta.count; i++)
+    mirror[delta.cells[i].row * cols + delta.cells[i].col] =
+        delta.cells[i].value;
+
+  return delta.count;
+}
+
+TEST_F(TetrisPersistTest, SkipsSavesOfGamesNotPersistent) {
+  // Arrange
+  s21::TetrisModel kept, skipped;
+
+  skipped.setPersistent(false);
+
+  // Act
+  startTetris(&skipped);
+  skipped.setKey(Keys::QUIT);
+  skipped.userInput(UserAction_t::Terminate, false);
+  PersistFlush();
+
+  // A save creates the directory of the records even for a zero score
+  bool skippedSaved = std::filesystem::exists("records");
+
+  startTetris(&kept);
+  kept.setKey(Keys::QUIT);
+  kept.userInput(UserAction_t::Terminate, false);
+  PersistFlush();
+
+  bool keptSaved = std::filesystem::exists("records");
+
+  // Assert
+  EXPECT_FALSE(skippedSaved);
+  EXPECT_TRUE(keptSaved);
+}
+
+TEST_F(TetrisPersistTest, LoadsHighScoreOnlyWhenAsked) {
+  // Arrange
+  std::filesystem::create_directories("records");
+  std::ofstream(ScoreStoreLegacyPath) << "HighScore = 50";
+
+  TetrisSimulator sim;
+  s21::VectorEnv env(s21::EnvGame::Snake, 2, 1);
+  s21::TetrisModel tetris;
+  s21::SnakeModel snake;
+
+  TetrisSimInit(&sim);
+
+  // Act
+  int simulated = sim.ctx.gameInfo.high_score;
+  int untouched = tetris.updateCurrentState().high_score;
+  bool migrated = std::filesystem::exists("records/tetris") ||
+                  std::filesystem::exists("records/snake");
+
+  tetris.loadHighScore();
+  snake.loadHighScore();
+
+  TetrisSimDestroy(&sim);
+
+  // Assert
+  EXPECT_EQ(simulated, 0);
+  EXPECT_EQ(untouched, 0);
+  EXPECT_FALSE(migrated);
+  EXPECT_EQ(tetris.updateCurrentState().high_score, 50);
+  EXPECT_EQ(snake.updateCurrentState().high_score, 50);
+  EXPECT_TRUE(std::filesystem::exists("records/tetris"));
+}
+
+void startTetris(s21::TetrisModel *model) {
+  model->setKey(Keys::ENTER);
+  model->userInput(UserAction_t::Start, false);
+}
+
+int countFigureCells(int **field) {
+  int counter = 0;
+
+  for (int i = 0; i < FieldRows - 1; i++)
+    for (int j = LeftBorder; j < RightBorder; j++)
+      if (field[i][j] >= FigureSym) counter++;
+
+  return counter;
+}
@@ -0,0 +1,176 @@
+#include "tests_entry.h"
+
+int countBits(const uint16_t *rows, int count);
+
+TEST(VectorEnvTest, TetrisBatch) {
+  // Arrange
+  const int games = 64;
+  s21::VectorEnv env(s21::EnvGame::Tetris, games, 4);
+
+  std::vector<UserAction_t> actions(games);
+  std::vector<uint16_t> observations(games * env.rows());
+  std::vector<float> rewards(games);
+
+  const UserAction_t pattern[] = {Start, Left, Start, Action, Right, Start};
+  TetrisSimulator reference;
+
+  env.seed(5);
+  ::TetrisSimInit(&reference);
+  ::TetrisSetSeed(&reference.ctx, 5);
+
+  // Act
+  for (int t = 0; t < 3000; t++) {
+    for (int i = 0; i < games; i++) actions[i] = pattern[(t + i) % 6];
+
+    env.step(actions.data(), observations.data(), rewards.data());
+    ::TetrisSimStep(&reference, &actions[0], 1);
+  }
+
+  // Assert
+  EXPECT_EQ(env.size(), games);
+  EXPECT_EQ(env.rows(), FieldRows - 1);
+  EXPECT_EQ(env.shards(), 4);
+
+  GameInfo_t info = ::TetrisUpdateCurrentState(&reference.ctx);
+
+  for (int r = 0; r < env.rows(); r++) {
+    uint16_t mask = 0;
+
+    for (int j = LeftBorder; j < RightBorder; j++)
+      if (info.field[r][j] != ' ') mask |= 1 << (j - LeftBorder);
+
+    EXPECT_EQ(observations[r], mask);
+  }
+
+  ::TetrisSimDestroy(&reference);
+
+  for (int i = 0; i < games; i++) {
+    const uint16_t *rows = observations.data() + i * env.rows();
+
+    EXPECT_GT(env.episodes()[i], 0u);
+    EXPECT_NE(env.states()[i], Launch);
+    EXPECT_GE(env.levels()[i], 1);
+
+    if (env.states()[i] == Moving) {
+      EXPECT_GT(countBits(rows, env.rows()), 0);
+    }
+
+    for (int r = 0; r < env.rows(); r++) EXPECT_EQ(rows[r] & ~0x3FF, 0);
+  }
+}
+
+TEST(VectorEnvTest, TetrisBag) {
+  // Arrange
+  const int games = 8;
+  s21::VectorEnv env(s21::EnvGame::Tetris, games, 2);
+
+  std::vector<UserAction_t> actions(games);
+  std::vector<uint16_t> observations(games * env.rows());
+  std::vector<float> rewards(games);
+
+  const UserAction_t pattern[] = {Start, Left, Start, Action, Right, Start};
+  TetrisSimulator reference;
+
+  env.seed(5);
+  env.bag(true);
+  ::TetrisSimInit(&reference);
+  ::TetrisSetSeed(&reference.ctx, 5);
+  ::TetrisSimSetBag(&reference, 1);
+
+  // Act
+  for (int t = 0; t < 2000; t++) {
+    for (int i = 0; i < games; i++) actions[i] = pattern[(t + i) % 6];
+
+    env.step(actions.data(), observations.data(), rewards.data());
+    ::TetrisSimStep(&reference, &actions[0], 1);
+  }
+
+  // Assert
+  GameInfo_t info = ::TetrisUpdateCurrentState(&reference.ctx);
+
+  for (int r = 0; r < env.rows(); r++) {
+    uint16_t mask = 0;
+
+    for (int j = LeftBorder; j < RightBorder; j++)
+      if (info.field[r][j] != ' ') mask |= 1 << (j - LeftBorder);
+
+    EXPECT_EQ(observations[r], mask);
+  }
+
+  EXPECT_EQ(env.scores()[0], reference.ctx.gameInfo.score);
+
+  ::TetrisSimDestroy(&reference);
+}
+
+TEST(VectorEnvTest, SnakeBatch) {
+  // Arrange
+  const int games = 16;
+  s21::VectorEnv env(s21::EnvGame::Snake, games, 2);
+  s21::SnakeModel reference;
+
+  std::vector<UserAction_t> actions(games, Start);
+  std::vector<uint16_t> observations(games * env.rows());
+  std::vector<float> rewards(games);
+
+  env.seed(2024);
+  reference.setRecords(nullptr);
+  reference.setSeed(2024);
+
+  // Act
+  for (int t = 0; t < 2; t++) {
+    env.step(actions.data(), observations.data(), rewards.data());
+
+    reference.setKey(t == 0 ? Keys::ENTER : -1);
+    reference.userInput(Start, false);
+  }
+
+  // Assert
+  EXPECT_EQ(env.rows(), static_cast<int>(s21::Field::height) - 1);
+
+  GameInfo_t info = reference.updateCurrentState();
+
+  for (int r = 0; r < env.rows(); r++) {
+    uint16_t mask = 0;
+
+    for (int j = 1; j < static_cast<int>(s21::Field::width) - 1; j++)
+      if (info.field[r][j] != ' ') mask |= 1 << (j - 1);
+
+    EXPECT_EQ(observations[r], mask);
+  }
+
+  for (int i = 0; i < games; i++) {
+    const uint16_t *rows = observations.data() + i * env.rows();
+
+    EXPECT_EQ(env.states()[i], Moving);
+    EXPECT_EQ(countBits(rows, env.rows()), 5);
+    EXPECT_EQ(rewards[i], 0.0f);
+  }
+
+  // Act
+  for (int t = 0; t < 20; t++)
+    env.step(actions.data(), observations.data(), rewards.data());
+
+  // Assert
+  for (int i = 0; i < games; i++) EXPECT_GE(env.episodes()[i], 1u);
+}
+
+TEST(VectorEnvTest, RejectsTerminate) {
+  // Arrange
+  s21::VectorEnv env(s21::EnvGame::Tetris, 2);
+
+  std::vector<UserAction_t> actions = {Start, Terminate};
+  std::vector<uint16_t> observations(2 * env.rows());
+  std::vector<float> rewards(2);
+
+  // Act & Assert
+  EXPECT_THROW(env.step(actions.data(), observations.data(), rewards.data()),
+               std::invalid_argument);
+}
+
+int countBits(const uint16_t *rows, int count) {
+  int counter = 0;
+
+  for (int i = 0; i < count; i++) counter += __builtin_popcount(rows[i]);
+
+  return counter;
+}